@@ -21,6 +21,8 @@
 #include <stdint.h>
 #include <stddef.h>
 
+#include "lcd_ui_colours.h"
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -29,6 +31,108 @@ extern "C"
 	typedef struct lcd_ui_context lcd_ui_context_t;
 	typedef struct lcd_ui_widget lcd_ui_widget_t;
 
+#ifndef LCD_UI_ROTATE_TILE
+/**
+ * @brief Edge length of the square tiles used when rotating pixel blocks.
+ *        16 keeps a source and destination tile well inside L1 cache.
+ */
+#define LCD_UI_ROTATE_TILE 16U
+#endif
+
+#ifndef LCD_UI_GRADIENT_SPAN
+/**
+ * @brief Pixels per gradient run handed to the driver. Must be a multiple
+ *        of 4 so dither patterns line up when a run is repeated.
+ */
+#define LCD_UI_GRADIENT_SPAN 32U
+#endif
+
+#ifndef LCD_UI_MAX_DAMAGE_RECTS
+/**
+ * @brief Number of damage rectangles tracked per frame before merging.
+ */
+#define LCD_UI_MAX_DAMAGE_RECTS 8U
+#endif
+
+#ifndef LCD_UI_SPAN_BATCH
+/**
+ * @brief Spans collected before they are handed to the driver at once.
+ */
+#define LCD_UI_SPAN_BATCH 32U
+#endif
+
+	/**
+	 * @brief Axis-aligned screen rectangle in pixels.
+	 */
+	typedef struct
+	{
+		uint16_t x;
+		uint16_t y;
+		uint16_t width;
+		uint16_t height;
+	} lcd_ui_rect_t;
+
+	/**
+	 * @brief One horizontal run of pixels, the unit shapes are filled in.
+	 */
+	typedef struct
+	{
+		uint16_t x;
+		uint16_t y;
+		uint16_t length;
+	} lcd_ui_span_t;
+
+	/**
+	 * @brief Logical screen rotation, clockwise, relative to the panel.
+	 */
+	typedef enum
+	{
+		LCD_UI_ROTATION_0 = 0,
+		LCD_UI_ROTATION_90,
+		LCD_UI_ROTATION_180,
+		LCD_UI_ROTATION_270,
+	} lcd_ui_rotation_t;
+
+	/**
+	 * @brief Pixel layouts a driver framebuffer can use.
+	 */
+	typedef enum
+	{
+		LCD_UI_PIXEL_ARGB8888 = 0,
+		LCD_UI_PIXEL_RGB565,
+	} lcd_ui_pixel_format_t;
+
+	/**
+	 * @brief Describes a directly addressable draw target.
+	 */
+	typedef struct
+	{
+		void *pixels;
+		uint16_t width;
+		uint16_t height;
+		uint16_t stride; /* pixels per row */
+		lcd_ui_pixel_format_t format;
+	} lcd_ui_framebuffer_t;
+
+	/**
+	 * @brief Axis a gradient runs along.
+	 */
+	typedef enum
+	{
+		LCD_UI_GRADIENT_HORIZONTAL = 0, /* start colour at the left edge */
+		LCD_UI_GRADIENT_VERTICAL,       /* start colour at the top edge */
+	} lcd_ui_gradient_direction_t;
+
+	/**
+	 * @brief Two-stop linear gradient.
+	 */
+	typedef struct
+	{
+		uint32_t start_colour;
+		uint32_t end_colour;
+		lcd_ui_gradient_direction_t direction;
+	} lcd_ui_gradient_t;
+
 	/**
 	 * @brief Widget text alignment
 	 */
@@ -58,8 +162,37 @@ extern "C"
 		LCD_UI_WIDGET_SLIDER,
 		LCD_UI_WIDGET_PROGRESS_BAR,
 		LCD_UI_WIDGET_LABEL,
+		LCD_UI_WIDGET_CHART, /* data: lcd_ui_chart_t */
+		LCD_UI_WIDGET_LIST,  /* data: lcd_ui_list_t */
+		LCD_UI_WIDGET_TABLE, /* data: lcd_ui_table_t */
+		LCD_UI_WIDGET_IMAGE, /* data: const lcd_ui_image_t */
+		LCD_UI_WIDGET_GAUGE,    /* data: lcd_ui_gauge_t */
+		LCD_UI_WIDGET_KEYBOARD, /* data: lcd_ui_keyboard_t */
 	} lcd_ui_widget_type_t;
 
+	/**
+	 * @brief Shared look for any number of widgets (flyweight). Widgets
+	 *        refer to a style by index into the context's theme, so the
+	 *        derived shades live here once rather than in every widget.
+	 */
+	typedef struct
+	{
+		uint32_t background;
+		uint32_t text;
+		lcd_ui_palette_t shades; /* pressed, disabled, ... variants */
+		uint8_t margin;          /* text inset from left/right aligned edges */
+	} lcd_ui_style_t;
+
+	/**
+	 * @brief Constant initialiser for an lcd_ui_style_t, for themes kept
+	 *        in flash. Gives the same shades as lcd_ui_build_style().
+	 */
+#define LCD_UI_STYLE(background_value, text_value, margin_value)                     \
+	{                                                                            \
+		(background_value), (text_value),                                    \
+		LCD_UI_PALETTE(background_value, text_value), (uint8_t)(margin_value) \
+	}
+
 	/**
 	 * @brief Represents a single UI widget in the system.
 	 */
@@ -69,54 +202,208 @@ extern "C"
 		uint16_t y;
 		uint16_t width;
 		uint16_t height;
-		lcd_ui_widget_type_t type;
 
 		lcd_ui_touch_callback_t on_touch;
 		void *user_data;
 
 		const char *label_text;
 
-		uint8_t progress_percent;
+		/* State owned by the widget type, e.g. lcd_ui_chart_t */
+		void *data;
+
 		uint32_t slider_value;
 
+		/* Own colours, used while style is 0 */
 		uint32_t background_color;
 		uint32_t text_color;
 
-		lcd_ui_align_t text_align;
-
 		void (*slider_update_callback)(lcd_ui_context_t *ctx,
 					       lcd_ui_widget_t *widget,
 					       uint32_t new_value);
+
+		/* Optional button face / progress fill gradient; NULL fills flat */
+		const lcd_ui_gradient_t *gradient;
+
+		/* Byte-sized fields last so they pack into one word */
+		uint8_t type;       /* lcd_ui_widget_type_t */
+		uint8_t text_align; /* lcd_ui_align_t */
+		uint8_t progress_percent;
+		uint8_t style; /* 1-based index into the theme, 0 for own colours */
 	};
 
+	/**
+	 * @brief Save-under record for a transient overlay (popup, dialog,
+	 *        dropdown). Owned by the caller, as is the pixel buffer.
+	 */
+	typedef struct lcd_ui_overlay
+	{
+		lcd_ui_widget_t *widget;
+		void *save_buffer;
+		size_t save_buffer_size;
+		lcd_ui_rect_t area; /* logical region that was saved */
+		uint8_t saved;      /* buffer still matches what lies beneath */
+		struct lcd_ui_overlay *next;
+	} lcd_ui_overlay_t;
+
+	/**
+	 * @brief Display driver. Every callback receives the opaque instance
+	 *        pointer given to lcd_ui_init(), so one driver can serve
+	 *        several panels.
+	 */
 	typedef struct
 	{
-		void (*init)(void);
-		void (*set_backlight)(uint8_t level);
-		void (*draw_pixel)(uint16_t x, uint16_t y, uint32_t colour);
-		void (*draw_rect)(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint32_t colour);
-		void (*draw_text)(uint16_t x, uint16_t y, const char *text, uint32_t text_colour, uint32_t background_colour, lcd_ui_align_t align);
-		void (*clear)(uint32_t colour);
-		void (*get_screen_size)(uint16_t *w, uint16_t *h);
-		uint16_t (*get_font_width)(void);
-		uint16_t (*get_font_height)(void);
+		void (*init)(void *instance);
+		void (*set_backlight)(void *instance, uint8_t level);
+		void (*draw_pixel)(void *instance, uint16_t x, uint16_t y, uint32_t colour);
+		void (*draw_rect)(void *instance, uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint32_t colour);
+		void (*draw_text)(void *instance, uint16_t x, uint16_t y, const char *text, uint32_t text_colour, uint32_t background_colour, lcd_ui_align_t align);
+		void (*clear)(void *instance, uint32_t colour);
+		void (*get_screen_size)(void *instance, uint16_t *w, uint16_t *h);
+		uint16_t (*get_font_width)(void *instance);
+		uint16_t (*get_font_height)(void *instance);
+
+		/*
+		 * Optional double buffering. Leave NULL for single-buffered panels.
+		 */
+
+		/**
+		 * @brief Shows the back buffer at the next vertical blank and
+		 *        returns once the old front buffer has become the new
+		 *        draw target.
+		 */
+		void (*flip)(void *instance);
+
+		/**
+		 * @brief Copies a region from the displayed buffer into the
+		 *        draw target, bringing a stale back buffer up to date.
+		 */
+		void (*sync_rect)(void *instance, uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+
+		/*
+		 * Optional pixel access. Leave NULL where the target is not memory.
+		 */
+
+		/**
+		 * @brief Describes the current draw target.
+		 * @return Non-zero if @p framebuffer was filled in.
+		 */
+		uint8_t (*get_framebuffer)(void *instance, lcd_ui_framebuffer_t *framebuffer);
+
+		/**
+		 * @brief Moves a block within the draw target. Source and
+		 *        destination may overlap. Without it lcd_ui falls back
+		 *        to memmove() on the framebuffer.
+		 */
+		void (*copy_rect)(void *instance,
+				  uint16_t src_x, uint16_t src_y,
+				  uint16_t w, uint16_t h,
+				  uint16_t dst_x, uint16_t dst_y);
+
+		/**
+		 * @brief Writes a block of ARGB8888 pixels. @p stride is the
+		 *        source row length in pixels. Without it lcd_ui writes
+		 *        through get_framebuffer.
+		 */
+		void (*draw_bitmap)(void *instance,
+				    uint16_t x, uint16_t y,
+				    uint16_t w, uint16_t h,
+				    const uint32_t *pixels, uint16_t stride);
+
+		/**
+		 * @brief Fills a batch of horizontal spans in one colour, in
+		 *        panel coordinates. Without it lcd_ui writes spans
+		 *        through get_framebuffer, or else one draw_rect each.
+		 */
+		void (*fill_spans)(void *instance,
+				   const lcd_ui_span_t *spans, uint16_t count,
+				   uint32_t colour);
+
+		/**
+		 * @brief Blends one colour into a one-pixel-wide run (w x 1 or
+		 *        1 x h) in panel coordinates, by per-pixel coverage in
+		 *        panel order: 0 leaves a pixel alone, 255 replaces it.
+		 *        Without it lcd_ui blends in the framebuffer, or else
+		 *        fills the pixels that are at least half covered.
+		 */
+		void (*blend_span)(void *instance,
+				   uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+				   const uint8_t *coverage, uint32_t colour);
+
+		/**
+		 * @brief Returns the bitmap of one character in the current
+		 *        font: get_font_height() rows of (width + 7) / 8 bytes,
+		 *        most significant bit leftmost. Needed to draw text
+		 *        while the screen is rotated.
+		 */
+		const uint8_t *(*get_glyph)(void *instance, char c);
+
+		/**
+		 * @brief Free-running microsecond counter, used to time touch
+		 *        feedback. Only differences are taken, so it may wrap.
+		 *        Leave NULL to skip latency tracking.
+		 */
+		uint32_t (*get_time_us)(void *instance);
 	} lcd_ui_driver_t;
 
+	/**
+	 * @brief Rendering state for one display. Contexts share nothing, so
+	 *        each panel can be driven from its own task.
+	 */
 	struct lcd_ui_context
 	{
 		const lcd_ui_driver_t *driver;
+		void *driver_instance;
 		lcd_ui_widget_t **widgets;
 		uint8_t widget_capacity;
 		uint8_t widget_count;
 		uint16_t screen_width;
 		uint16_t screen_height;
 
+		/* Panel size; screen_width/height are the rotated logical size */
+		uint16_t native_width;
+		uint16_t native_height;
+		lcd_ui_rotation_t rotation;
+
 		lcd_ui_widget_t *active_widget;
 		uint8_t touch_active;
+
+		/* Button drawn in its pressed state, if any */
+		const lcd_ui_widget_t *pressed_widget;
+
+		/* Press-to-feedback timing; pending until the feedback is shown */
+		uint32_t press_time_us;
+		uint32_t feedback_latency_us;
+		uint32_t feedback_latency_max_us;
+		uint8_t feedback_pending;
+
+		/* Colour of the last lcd_ui_reset_screen(), shown where no widget is */
+		uint32_t background_colour;
+
+		/* Overlays currently shown, and the widget being drawn right now */
+		lcd_ui_overlay_t *overlays;
+		const lcd_ui_widget_t *drawing_widget;
+
+		/* Theme: widget style n uses styles[n - 1] */
+		const lcd_ui_style_t *styles;
+		uint8_t style_count;
+		uint32_t theme_version; /* bumped by lcd_ui_set_theme() */
+
+		/* Regions drawn since the last lcd_ui_present(), in panel coordinates */
+		lcd_ui_rect_t damage[LCD_UI_MAX_DAMAGE_RECTS];
+		uint8_t damage_count;
+
+		/* Regions the back buffer is missing after the last flip */
+		lcd_ui_rect_t stale[LCD_UI_MAX_DAMAGE_RECTS];
+		uint8_t stale_count;
+
+		/* Fills are clipped to clip; text must also fit inside scissor */
+		lcd_ui_rect_t clip;
+		lcd_ui_rect_t scissor;
 	};
 
 	void lcd_ui_init(lcd_ui_context_t *ctx,
 			 const lcd_ui_driver_t *driver,
+			 void *driver_instance,
 			 lcd_ui_widget_t **widget_buffer,
 			 uint8_t capacity);
 
@@ -127,15 +414,324 @@ extern "C"
 
 	void lcd_ui_clear_widgets(lcd_ui_context_t *ctx);
 
-	void lcd_ui_render(const lcd_ui_context_t *ctx);
+	void lcd_ui_render(lcd_ui_context_t *ctx);
 
 	void lcd_ui_handle_touch(lcd_ui_context_t *ctx,
 				 uint16_t x, uint16_t y,
 				 uint8_t is_pressed);
 
-	void lcd_ui_redraw_widget(const lcd_ui_context_t *context,
+	void lcd_ui_redraw_widget(lcd_ui_context_t *context,
 				  const lcd_ui_widget_t *widget);
 
+	/**
+	 * @brief Finishes a frame. On double-buffered drivers the back buffer
+	 *        is flipped to the panel and this frame's damage is queued to
+	 *        be copied forward before the next frame draws over it.
+	 *        On single-buffered drivers it only resets damage tracking.
+	 * @param ctx Pointer to initialized lcd_ui_context_t
+	 */
+	void lcd_ui_present(lcd_ui_context_t *ctx);
+
+	/**
+	 * @brief Scrolls the pixels inside @p region by (dx, dy) and repaints
+	 *        only the strip that was uncovered.
+	 *
+	 *        Move the scrolled widgets by the same offset before calling.
+	 *        Widgets wholly inside the region are treated as scrolled
+	 *        content; widgets crossing its edge are repainted clipped to
+	 *        it. Overlays, and widgets listed after scrolled content they
+	 *        cover, stay put: they are repainted in place and over the
+	 *        pixels dragged from them. A widget floating over nothing but
+	 *        background is taken as content; show it as an overlay.
+	 *        Text is only drawn once its full cell is inside the region.
+	 *
+	 * @param ctx               Pointer to initialized lcd_ui_context_t
+	 * @param region            Area to scroll
+	 * @param dx                Horizontal offset, positive moves right
+	 * @param dy                Vertical offset, positive moves down
+	 * @param background_colour Fill for uncovered pixels no widget owns
+	 */
+	void lcd_ui_scroll_region(lcd_ui_context_t *ctx,
+				  const lcd_ui_rect_t *region,
+				  int16_t dx, int16_t dy,
+				  uint32_t background_colour);
+
+	/**
+	 * @brief Moves the pixels inside @p area by (dx, dy) and repaints
+	 *        nothing: the uncovered strip keeps what was there. Whatever
+	 *        would land off screen is dropped. Ignores ctx->clip.
+	 * @param ctx  Pointer to initialized lcd_ui_context_t
+	 * @param area Logical area to move
+	 * @param dx   Horizontal offset, positive moves right
+	 * @param dy   Vertical offset, positive moves down
+	 * @return 0 if the driver has neither copy_rect nor get_framebuffer
+	 */
+	uint8_t lcd_ui_move_pixels(lcd_ui_context_t *ctx,
+				   const lcd_ui_rect_t *area,
+				   int16_t dx, int16_t dy);
+
+	/**
+	 * @brief Repaints everything inside @p area: the widgets touching it
+	 *        in z-order, over the colour of the last lcd_ui_reset_screen().
+	 *        Use it for areas a widget has moved out of.
+	 * @param ctx  Pointer to initialized lcd_ui_context_t
+	 * @param area Logical area to repaint
+	 */
+	void lcd_ui_repaint_area(lcd_ui_context_t *ctx, const lcd_ui_rect_t *area);
+
+	/**
+	 * @brief Shows @p widget as a transient overlay on top of everything.
+	 *        What it covers is copied into @p save_buffer first, so hiding
+	 *        it is a single blit instead of a re-render. The buffer needs
+	 *        width * height * bytes-per-pixel of the framebuffer; if it is
+	 *        too small, or the driver has no get_framebuffer, hiding falls
+	 *        back to repainting the widgets beneath.
+	 * @param ctx              Pointer to initialized lcd_ui_context_t
+	 * @param overlay          Caller-owned record, valid until hidden
+	 * @param widget           Widget to show; added to the top of the list
+	 * @param save_buffer      Caller-owned pixel storage
+	 * @param save_buffer_size Size of @p save_buffer in bytes
+	 * @return 0 if the widget list is full; nothing is shown. Showing an
+	 *         overlay that is already up only redraws it.
+	 */
+	uint8_t lcd_ui_show_overlay(lcd_ui_context_t *ctx,
+				    lcd_ui_overlay_t *overlay,
+				    lcd_ui_widget_t *widget,
+				    void *save_buffer,
+				    size_t save_buffer_size);
+
+	/**
+	 * @brief Removes an overlay and restores what it covered. The saved
+	 *        pixels are used unless something beneath was redrawn while the
+	 *        overlay was up, in which case that area is repainted instead.
+	 * @param ctx     Pointer to initialized lcd_ui_context_t
+	 * @param overlay Record passed to lcd_ui_show_overlay()
+	 */
+	void lcd_ui_hide_overlay(lcd_ui_context_t *ctx, lcd_ui_overlay_t *overlay);
+
+	/**
+	 * @brief Rotates the logical screen. Widgets are laid out in the rotated
+	 *        coordinate system and touches are mapped into it; re-render
+	 *        afterwards. Text needs the driver's get_glyph when rotated.
+	 * @param ctx      Pointer to initialized lcd_ui_context_t
+	 * @param rotation Clockwise rotation relative to the panel
+	 */
+	void lcd_ui_set_rotation(lcd_ui_context_t *ctx, lcd_ui_rotation_t rotation);
+
+	/**
+	 * @brief Draws a block of ARGB8888 pixels at logical coordinates,
+	 *        clipped and rotated to the panel.
+	 * @param ctx    Pointer to initialized lcd_ui_context_t
+	 * @param x      Left edge
+	 * @param y      Top edge
+	 * @param w      Width in pixels
+	 * @param h      Height in pixels
+	 * @param pixels First pixel of the block
+	 * @param stride Source row length in pixels
+	 */
+	void lcd_ui_draw_bitmap(lcd_ui_context_t *ctx,
+				uint16_t x, uint16_t y,
+				uint16_t w, uint16_t h,
+				const uint32_t *pixels, uint16_t stride);
+
+	/**
+	 * @brief Draws a block of RGB565 pixels at logical coordinates,
+	 *        clipped and rotated to the panel. On an unrotated RGB565
+	 *        framebuffer without draw_bitmap the rows are copied straight
+	 *        in; otherwise they are widened to ARGB8888 a tile at a time.
+	 * @param ctx    Pointer to initialized lcd_ui_context_t
+	 * @param x      Left edge
+	 * @param y      Top edge
+	 * @param w      Width in pixels
+	 * @param h      Height in pixels
+	 * @param pixels First pixel of the block
+	 * @param stride Source row length in pixels
+	 */
+	void lcd_ui_draw_rgb565(lcd_ui_context_t *ctx,
+				uint16_t x, uint16_t y,
+				uint16_t w, uint16_t h,
+				const uint16_t *pixels, uint16_t stride);
+
+	/**
+	 * @brief Fills a rectangle at logical coordinates, clipped and
+	 *        recorded as damage like any widget drawing.
+	 * @param ctx    Pointer to initialized lcd_ui_context_t
+	 * @param x      Left edge
+	 * @param y      Top edge
+	 * @param w      Width in pixels
+	 * @param h      Height in pixels
+	 * @param colour Fill colour
+	 */
+	void lcd_ui_fill_rect(lcd_ui_context_t *ctx,
+			      uint16_t x, uint16_t y,
+			      uint16_t w, uint16_t h,
+			      uint32_t colour);
+
+	/**
+	 * @brief Fills horizontal spans at logical coordinates in one colour,
+	 *        clipped and recorded as damage. The shape primitives in
+	 *        lcd_ui_shapes.h are built on this.
+	 * @param ctx    Pointer to initialized lcd_ui_context_t
+	 * @param spans  Spans to fill
+	 * @param count  Number of spans
+	 * @param colour Fill colour
+	 */
+	void lcd_ui_fill_spans(lcd_ui_context_t *ctx,
+			       const lcd_ui_span_t *spans, uint16_t count,
+			       uint32_t colour);
+
+	/**
+	 * @brief Blends one colour into horizontal spans at logical
+	 *        coordinates by per-pixel coverage, in linear light (see
+	 *        lcd_ui_gamma.h). Clipped and recorded as damage. The
+	 *        anti-aliased primitives in lcd_ui_shapes.h send their edge
+	 *        pixels through this and their solid interior through
+	 *        lcd_ui_fill_spans().
+	 * @param ctx      Pointer to initialized lcd_ui_context_t
+	 * @param spans    Spans to blend
+	 * @param count    Number of spans
+	 * @param coverage One value per pixel, 0 (untouched) to 255 (opaque),
+	 *                 for each span in turn
+	 * @param colour   Colour to blend in
+	 */
+	void lcd_ui_blend_spans(lcd_ui_context_t *ctx,
+				const lcd_ui_span_t *spans, uint16_t count,
+				const uint8_t *coverage, uint32_t colour);
+
+	/**
+	 * @brief Draws left-aligned text at logical coordinates, recorded as
+	 *        damage. Like widget labels, unrotated text is drawn whole if
+	 *        it touches ctx->clip and fits inside ctx->scissor, and
+	 *        skipped otherwise.
+	 * @param ctx               Pointer to initialized lcd_ui_context_t
+	 * @param x                 Left edge
+	 * @param y                 Top edge
+	 * @param text              NUL-terminated string
+	 * @param text_colour       Glyph colour
+	 * @param background_colour Cell background colour
+	 */
+	void lcd_ui_draw_text(lcd_ui_context_t *ctx,
+			      uint16_t x, uint16_t y, const char *text,
+			      uint32_t text_colour, uint32_t background_colour);
+
+	/**
+	 * @brief The theme style a widget uses, or NULL when it has its own
+	 *        colours.
+	 */
+	const lcd_ui_style_t *lcd_ui_get_widget_style(const lcd_ui_context_t *ctx,
+						      const lcd_ui_widget_t *widget);
+
+	/**
+	 * @brief The background and text colours a widget is drawn with,
+	 *        from its style when it has one.
+	 * @param ctx        Pointer to initialized lcd_ui_context_t
+	 * @param widget     Widget to look up
+	 * @param background Receives the background colour, may be NULL
+	 * @param foreground Receives the text/foreground colour, may be NULL
+	 */
+	void lcd_ui_get_widget_colours(const lcd_ui_context_t *ctx,
+				       const lcd_ui_widget_t *widget,
+				       uint32_t *background, uint32_t *foreground);
+
+	/**
+	 * @brief Gives the screen area a widget draws into. Labels reach
+	 *        past their own box: one text line high, and the whole line
+	 *        wide unless left-aligned.
+	 * @param ctx    Pointer to initialized lcd_ui_context_t
+	 * @param widget Widget to look up
+	 * @param bounds Receives the area in logical coordinates
+	 */
+	void lcd_ui_get_widget_bounds(const lcd_ui_context_t *ctx,
+				      const lcd_ui_widget_t *widget,
+				      lcd_ui_rect_t *bounds);
+
+	/**
+	 * @brief Fills in a style's derived shades from its base colours.
+	 *        Call once per style when building or changing a theme, not
+	 *        per draw.
+	 * @param style      Style to fill in
+	 * @param background Base background colour
+	 * @param text       Base text colour
+	 * @param margin     Text inset in pixels
+	 */
+	void lcd_ui_build_style(lcd_ui_style_t *style,
+				uint32_t background, uint32_t text,
+				uint8_t margin);
+
+	/**
+	 * @brief Switches the theme and repaints every widget in one pass.
+	 *        Widgets with style n take styles[n - 1]; the array must
+	 *        outlive its use and may be const (flash).
+	 * @param ctx         Pointer to initialized lcd_ui_context_t
+	 * @param styles      Array of built styles, or NULL for none
+	 * @param style_count Number of entries in @p styles
+	 */
+	void lcd_ui_set_theme(lcd_ui_context_t *ctx,
+			      const lcd_ui_style_t *styles,
+			      uint8_t style_count);
+
+	/**
+	 * @brief Fills a rectangle with a linear gradient. Colours are
+	 *        interpolated in fixed point and sent to the driver a run at a
+	 *        time; on RGB565 targets they are ordered-dithered.
+	 * @param ctx      Pointer to initialized lcd_ui_context_t
+	 * @param x        Left edge
+	 * @param y        Top edge
+	 * @param w        Width in pixels
+	 * @param h        Height in pixels
+	 * @param gradient Colours and direction
+	 */
+	void lcd_ui_fill_gradient(lcd_ui_context_t *ctx,
+				  uint16_t x, uint16_t y,
+				  uint16_t w, uint16_t h,
+				  const lcd_ui_gradient_t *gradient);
+
+	/**
+	 * @brief Copies a w x h ARGB8888 block into @p dst rotated clockwise.
+	 *        90/270 degrees swap the destination's width and height.
+	 *        Transposes run tile by tile (LCD_UI_ROTATE_TILE) so both the
+	 *        row-order reads and column-order writes stay cache resident.
+	 * @param src        First source pixel
+	 * @param src_stride Source row length in pixels
+	 * @param width      Source width
+	 * @param height     Source height
+	 * @param dst        First destination pixel
+	 * @param dst_stride Destination row length in pixels
+	 * @param rotation   Clockwise rotation to apply
+	 */
+	void lcd_ui_rotate_pixels(const uint32_t *src, uint16_t src_stride,
+				  uint16_t width, uint16_t height,
+				  uint32_t *dst, uint16_t dst_stride,
+				  lcd_ui_rotation_t rotation);
+
+/**
+ * @brief Angle units in a full turn for lcd_ui_sin() and lcd_ui_cos().
+ */
+#define LCD_UI_ANGLE_TURN 1024U
+
+	/**
+	 * @brief Sine from a lookup table, no floating point.
+	 * @param angle Angle, LCD_UI_ANGLE_TURN units per turn
+	 * @return sin(angle) in Q14 (16384 is 1.0)
+	 */
+	int16_t lcd_ui_sin(uint16_t angle);
+
+	/**
+	 * @brief Cosine from the same table as lcd_ui_sin().
+	 */
+	int16_t lcd_ui_cos(uint16_t angle);
+
+	/**
+	 * @brief Time from a button press reaching lcd_ui_handle_touch() to its
+	 *        pressed state being on screen (drawn, or flipped when double
+	 *        buffered). Needs the driver's get_time_us.
+	 * @param ctx      Pointer to initialized lcd_ui_context_t
+	 * @param last_us  Latest press, may be NULL
+	 * @param worst_us Slowest press since lcd_ui_init(), may be NULL
+	 */
+	void lcd_ui_get_feedback_latency(const lcd_ui_context_t *ctx,
+					 uint32_t *last_us, uint32_t *worst_us);
+
 	uint16_t lcd_ui_get_screen_width(const lcd_ui_context_t *ctx);
 
 	uint16_t lcd_ui_get_screen_height(const lcd_ui_context_t *ctx);
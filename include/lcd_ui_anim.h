@@ -0,0 +1,187 @@
+/**
+ * @file        lcd_ui_anim.h
+ * @brief       Tween scheduler animating widget properties frame by frame.
+ *
+ * @author      Ryan Hicks <c3361231@uon.edu.au>
+ *              School of Engineering (Electrical and Computer Engineering)
+ *              University of Newcastle
+ *
+ * @date        2025-04-11
+ * @version     1.0.0
+ *
+ * @copyright   Copyright (c) 2025 Ryan
+ * @license     SPDX-License-Identifier: MIT
+ *
+ * @note        Redistribution and use permitted with attribution.
+ */
+
+#ifndef LCD_UI_ANIM_H
+#define LCD_UI_ANIM_H
+
+#include "lcd_ui.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+
+	/**
+	 * @brief How a tween's progress maps onto its value. Worked out in
+	 *        16.16 fixed point.
+	 */
+	typedef enum
+	{
+		LCD_UI_EASE_LINEAR = 0,
+		LCD_UI_EASE_IN,     /* quadratic: starts slow */
+		LCD_UI_EASE_OUT,    /* quadratic: ends slow */
+		LCD_UI_EASE_IN_OUT, /* cubic smoothstep: slow at both ends */
+	} lcd_ui_easing_t;
+
+	/**
+	 * @brief Applies an easing curve.
+	 * @param easing   Curve
+	 * @param progress Time through the animation, 0 to 65536
+	 * @return Distance through the animation, 0 to 65536
+	 */
+	uint32_t lcd_ui_ease(lcd_ui_easing_t easing, uint32_t progress);
+
+	/**
+	 * @brief Widget property a tween drives.
+	 */
+	typedef enum
+	{
+		LCD_UI_TWEEN_X = 0,
+		LCD_UI_TWEEN_Y,
+		LCD_UI_TWEEN_BACKGROUND, /* background_color, used while style is 0 */
+		LCD_UI_TWEEN_TEXT,       /* text_color, used while style is 0 */
+		LCD_UI_TWEEN_VALUE,      /* slider_value */
+		LCD_UI_TWEEN_PROGRESS,   /* progress_percent */
+		LCD_UI_TWEEN_CUSTOM,     /* handed to the tween's apply callback */
+	} lcd_ui_tween_property_t;
+
+	/**
+	 * @brief Sets a custom animated value, e.g. a gauge reading or a
+	 *        spinner angle, and draws whatever it changes. Called after
+	 *        the frame's other damage has been repainted.
+	 */
+	typedef void (*lcd_ui_tween_apply_t)(lcd_ui_context_t *ctx,
+					     lcd_ui_widget_t *widget,
+					     int32_t value,
+					     void *user_data);
+
+	/**
+	 * @brief One slot of the tween pool. Colours are interpolated in
+	 *        linear light, everything else as integers.
+	 */
+	typedef struct
+	{
+		lcd_ui_widget_t *widget; /* NULL while the slot is free */
+		int32_t from;
+		int32_t to;
+		uint32_t start_us;
+		uint32_t duration_us;
+
+		lcd_ui_tween_apply_t apply; /* LCD_UI_TWEEN_CUSTOM only */
+		void *user_data;
+
+		uint8_t property; /* lcd_ui_tween_property_t */
+		uint8_t easing;   /* lcd_ui_easing_t */
+		uint8_t loop;     /* restart from @c from when finished */
+		uint8_t started;  /* start_us set by the first frame */
+	} lcd_ui_tween_t;
+
+	/**
+	 * @brief Animation state for one context. The tween pool is owned by
+	 *        the caller.
+	 */
+	typedef struct
+	{
+		lcd_ui_context_t *ctx;
+		lcd_ui_tween_t *tweens;
+		uint8_t capacity;
+
+		/* Frames fall on a fixed grid frame_us apart */
+		uint32_t frame_us;
+		uint32_t next_frame_us;
+		uint8_t running;
+
+		/* Areas repainted by the last frame, logical coordinates */
+		lcd_ui_rect_t damage[LCD_UI_MAX_DAMAGE_RECTS];
+		uint8_t damage_settled[LCD_UI_MAX_DAMAGE_RECTS]; /* holds a widget's new area */
+		uint8_t damage_count;
+
+		uint32_t frames;
+	} lcd_ui_animator_t;
+
+	/**
+	 * @brief Prepares an animator with an empty tween pool.
+	 * @param anim     Animator to initialise
+	 * @param ctx      Context the animated widgets belong to
+	 * @param tweens   Caller-owned pool
+	 * @param capacity Number of slots in @p tweens
+	 * @param frame_us Shortest time between frames, e.g. 33333 for 30 Hz;
+	 *                 0 draws a frame on every tick
+	 */
+	void lcd_ui_animator_init(lcd_ui_animator_t *anim, lcd_ui_context_t *ctx,
+				  lcd_ui_tween_t *tweens, uint8_t capacity,
+				  uint32_t frame_us);
+
+	/**
+	 * @brief Animates a widget property from its current value to @p to,
+	 *        starting at the next frame. A tween already running on the
+	 *        same widget and property is taken over from where it is.
+	 * @param anim        Animator
+	 * @param widget      Widget to animate; it must stay valid while the
+	 *                    tween runs
+	 * @param property    Property to drive (not LCD_UI_TWEEN_CUSTOM)
+	 * @param to          Final value
+	 * @param duration_us Length of the animation
+	 * @param easing      Easing curve
+	 * @return The tween, e.g. to set loop, or NULL if the pool is full
+	 */
+	lcd_ui_tween_t *lcd_ui_animate(lcd_ui_animator_t *anim, lcd_ui_widget_t *widget,
+				       lcd_ui_tween_property_t property, int32_t to,
+				       uint32_t duration_us, lcd_ui_easing_t easing);
+
+	/**
+	 * @brief Animates a value only @p apply knows how to show, such as a
+	 *        gauge reading or a spinner angle. One custom tween per widget.
+	 * @return The tween, or NULL if the pool is full
+	 */
+	lcd_ui_tween_t *lcd_ui_animate_custom(lcd_ui_animator_t *anim, lcd_ui_widget_t *widget,
+					      int32_t from, int32_t to,
+					      uint32_t duration_us, lcd_ui_easing_t easing,
+					      lcd_ui_tween_apply_t apply, void *user_data);
+
+	/**
+	 * @brief Stops every tween on @p widget where it is. Call before
+	 *        removing an animated widget.
+	 */
+	void lcd_ui_animation_stop(lcd_ui_animator_t *anim, const lcd_ui_widget_t *widget);
+
+	/**
+	 * @brief Whether any tween is running on @p widget, or on any widget
+	 *        when @p widget is NULL.
+	 */
+	uint8_t lcd_ui_animating(const lcd_ui_animator_t *anim, const lcd_ui_widget_t *widget);
+
+	/**
+	 * @brief Advances the animations. Call as often as convenient: a
+	 *        frame is drawn only when the next frame time has been
+	 *        reached, at most once per frame_us. Frames are timed on a
+	 *        fixed grid, so late ticks do not stretch the animation.
+	 *        Each frame repaints the new area of every changed widget
+	 *        and the parts of its old area it has moved out of.
+	 * @param anim   Animator
+	 * @param now_us Free-running microsecond clock; it may wrap
+	 * @return Non-zero if a frame was drawn
+	 */
+	uint8_t lcd_ui_tick(lcd_ui_animator_t *anim, uint32_t now_us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LCD_UI_ANIM_H */
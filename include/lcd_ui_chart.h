@@ -0,0 +1,183 @@
+/**
+ * @file        lcd_ui_chart.h
+ * @brief       Scrolling real-time chart widget backed by a ring buffer.
+ *
+ * @author      Ryan Hicks <c3361231@uon.edu.au>
+ *              School of Engineering (Electrical and Computer Engineering)
+ *              University of Newcastle
+ *
+ * @date        2025-04-11
+ * @version     1.0.0
+ *
+ * @copyright   Copyright (c) 2025 Ryan
+ * @license     SPDX-License-Identifier: MIT
+ *
+ * @note        Redistribution and use permitted with attribution.
+ */
+
+#ifndef LCD_UI_CHART_H
+#define LCD_UI_CHART_H
+
+#include "lcd_ui.h"
+#include "lcd_ui_decimate.h"
+#include "lcd_ui_samples.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+
+	/**
+	 * @brief How the vertical range follows the data.
+	 */
+	typedef enum
+	{
+		LCD_UI_CHART_SCALE_FIXED = 0, /* range stays as given */
+		LCD_UI_CHART_SCALE_EXPAND,    /* range grows to take in new samples */
+		LCD_UI_CHART_SCALE_FIT,       /* range follows the visible samples */
+	} lcd_ui_chart_scale_t;
+
+	/**
+	 * @brief Chart state, referenced by a LCD_UI_WIDGET_CHART widget's
+	 *        data pointer. One sample per pixel column, newest at the
+	 *        right edge.
+	 */
+	typedef struct
+	{
+		lcd_ui_samples_t source; /* ring buffer the plot reads */
+		int32_t *samples;        /* push storage, NULL for an acquisition buffer */
+		uint16_t capacity;       /* samples the buffer holds */
+		uint16_t count;    /* samples held so far, up to capacity */
+		uint16_t head;     /* where the next sample goes */
+		uint16_t pending;  /* samples pushed since the chart was drawn */
+
+		/* Acquisition mode: the producer only ever bumps completed */
+		volatile uint32_t completed; /* samples finished, written from the ISR */
+		uint32_t consumed;           /* part of completed taken in so far */
+
+		int32_t minimum; /* value at the bottom edge */
+		int32_t maximum; /* value at the top edge */
+		lcd_ui_chart_scale_t scale;
+		uint8_t rescaled; /* range changed; the next update redraws it all */
+
+		/* Decimated mode: a window of a pyramid, min/max per column */
+		const lcd_ui_pyramid_t *pyramid;
+		uint32_t view_start;
+		uint32_t view_length; /* 0 shows the whole series */
+		uint32_t view_count;  /* series length when last drawn */
+	} lcd_ui_chart_t;
+
+	/**
+	 * @brief Prepares a chart over a caller-owned sample buffer. Give it
+	 *        at least the widget's width plus one sample to fill the plot.
+	 * @param chart    Chart to initialise
+	 * @param samples  Ring buffer storage
+	 * @param capacity Number of samples in @p samples
+	 * @param minimum  Initial value at the bottom edge
+	 * @param maximum  Initial value at the top edge, above @p minimum
+	 * @param scale    Autoscale behaviour
+	 */
+	void lcd_ui_chart_init(lcd_ui_chart_t *chart,
+			       int32_t *samples, uint16_t capacity,
+			       int32_t minimum, int32_t maximum,
+			       lcd_ui_chart_scale_t scale);
+
+	/**
+	 * @brief Prepares a chart that plots a circular acquisition buffer,
+	 *        e.g. the target of an ADC in circular DMA mode, in place:
+	 *        no copy into chart storage and no conversion pass. Report
+	 *        each finished half with lcd_ui_chart_buffer_complete(); the
+	 *        next lcd_ui_chart_update() scrolls the new samples in.
+	 *        For a steady trace the buffer should hold the widget's
+	 *        width plus half a buffer, so the half being written stays
+	 *        off screen.
+	 * @param chart    Chart to initialise
+	 * @param source   Sample buffer descriptor, copied
+	 * @param capacity Number of samples in the buffer
+	 * @param minimum  Initial value at the bottom edge
+	 * @param maximum  Initial value at the top edge, above @p minimum
+	 * @param scale    Autoscale behaviour
+	 */
+	void lcd_ui_chart_init_source(lcd_ui_chart_t *chart,
+				      const lcd_ui_samples_t *source, uint16_t capacity,
+				      int32_t minimum, int32_t maximum,
+				      lcd_ui_chart_scale_t scale);
+
+	/**
+	 * @brief Notes that the producer has finished half of the buffer
+	 *        given to lcd_ui_chart_init_source(). Safe to call from the
+	 *        DMA half and full transfer interrupts while the main loop
+	 *        draws; it only advances a counter. On cores with a data
+	 *        cache, invalidate the finished half before calling.
+	 * @param chart Chart fed by the buffer
+	 * @param full  0 for the first half (half transfer), 1 for the
+	 *              second (transfer complete)
+	 */
+	void lcd_ui_chart_buffer_complete(lcd_ui_chart_t *chart, uint8_t full);
+
+	/**
+	 * @brief Prepares a chart that plots a min/max pyramid, each column
+	 *        showing the extremes of the samples under it. Suits series
+	 *        far longer than the chart is wide; append to the pyramid
+	 *        and call lcd_ui_chart_update() to show new data.
+	 * @param chart   Chart to initialise
+	 * @param pyramid Series to plot, caller-owned
+	 * @param minimum Initial value at the bottom edge
+	 * @param maximum Initial value at the top edge, above @p minimum
+	 * @param scale   Autoscale behaviour
+	 */
+	void lcd_ui_chart_init_decimated(lcd_ui_chart_t *chart,
+					 const lcd_ui_pyramid_t *pyramid,
+					 int32_t minimum, int32_t maximum,
+					 lcd_ui_chart_scale_t scale);
+
+	/**
+	 * @brief Zooms or pans a decimated chart and redraws it. Costs
+	 *        O(columns) whatever the window size.
+	 * @param ctx    Pointer to initialized lcd_ui_context_t
+	 * @param widget Chart widget
+	 * @param start  First sample shown
+	 * @param length Samples across the chart, 0 for the whole series
+	 */
+	void lcd_ui_chart_set_view(lcd_ui_context_t *ctx, lcd_ui_widget_t *widget,
+				   uint32_t start, uint32_t length);
+
+	/**
+	 * @brief Appends a sample. Draws nothing, so it is cheap enough to
+	 *        call at the acquisition rate; call lcd_ui_chart_update()
+	 *        once per frame to show what has arrived. Not safe against a
+	 *        concurrent update, so push from the same thread or guard it.
+	 * @param chart  Chart to append to
+	 * @param sample New value
+	 */
+	void lcd_ui_chart_push(lcd_ui_chart_t *chart, int32_t sample);
+
+	/**
+	 * @brief Shows samples pushed since the last draw. The plot is moved
+	 *        left by one column per sample with a block move, and only
+	 *        the uncovered columns are drawn. The whole chart is redrawn
+	 *        only when the range has changed.
+	 * @param ctx    Pointer to initialized lcd_ui_context_t
+	 * @param widget Chart widget
+	 */
+	void lcd_ui_chart_update(lcd_ui_context_t *ctx, lcd_ui_widget_t *widget);
+
+	/**
+	 * @brief Draws the columns of a chart widget that lie in ctx->clip.
+	 *        Called by lcd_ui while drawing widgets.
+	 * @param ctx        Pointer to initialized lcd_ui_context_t
+	 * @param widget     Chart widget
+	 * @param background Plot background colour
+	 * @param foreground Trace colour
+	 */
+	void lcd_ui_chart_draw(lcd_ui_context_t *ctx,
+			       const lcd_ui_widget_t *widget,
+			       uint32_t background, uint32_t foreground);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LCD_UI_CHART_H */
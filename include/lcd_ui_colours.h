@@ -13,6 +13,24 @@ extern "C"
 #endif
 
 #include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#if defined(__ARM_FEATURE_DSP)
+#include "cmsis_compiler.h" /* __UQADD8 */
+#endif
+
+/*
+ * The integer colour helpers below are constexpr in C++14 and later, so
+ * derived shades can be folded at compile time and checked with
+ * static_assert. C code gets the same results through the LCD_UI_*
+ * macros further down.
+ */
+#if defined(__cplusplus) && (__cplusplus >= 201402L)
+#define LCD_UI_CONSTEXPR constexpr
+#else
+#define LCD_UI_CONSTEXPR
+#endif
 
 	/**
 	 * @brief Holds RGBA channels in separate bytes.
@@ -50,10 +68,10 @@ extern "C"
 	 * @param blue_value  0..255 blue
 	 * @return 32-bit ARGB colour
 	 */
-	static inline uint32_t make_argb_colour(uint8_t alpha_value,
-						uint8_t red_value,
-						uint8_t green_value,
-						uint8_t blue_value)
+	static inline LCD_UI_CONSTEXPR uint32_t make_argb_colour(uint8_t alpha_value,
+								 uint8_t red_value,
+								 uint8_t green_value,
+								 uint8_t blue_value)
 	{
 		/* Compose four bytes into one 32-bit value. */
 		uint32_t colour_argb = 0U;
@@ -136,20 +154,259 @@ extern "C"
 		return result;
 	}
 
+	/**
+	 * @brief Scales the red, green, and blue channels by a Q8.8 factor with
+	 *        saturation, leaving alpha unchanged. Integer only, so it is
+	 *        safe without an FPU and inside interrupt handlers.
+	 *
+	 * @param argb_value 32-bit ARGB colour
+	 * @param factor_q8  256 => no change, 128 => half, 512 => double
+	 * @return Scaled 32-bit ARGB colour
+	 */
+	static inline LCD_UI_CONSTEXPR uint32_t scale_colour_by_q8(uint32_t argb_value,
+								   uint16_t factor_q8)
+	{
+		uint32_t red = (((argb_value >> 16) & 0xFFU) * factor_q8) >> 8;
+		uint32_t green = (((argb_value >> 8) & 0xFFU) * factor_q8) >> 8;
+		uint32_t blue = ((argb_value & 0xFFU) * factor_q8) >> 8;
+
+		red = (red > 255U) ? 255U : red;
+		green = (green > 255U) ? 255U : green;
+		blue = (blue > 255U) ? 255U : blue;
+
+		return (argb_value & 0xFF000000U) | (red << 16) | (green << 8) | blue;
+	}
+
+	/**
+	 * @brief A percentage as the single-precision float it would become,
+	 *        mantissa * 2^-shift with a 24-bit mantissa.
+	 */
+	typedef struct percentage_factor_t
+	{
+		uint32_t mantissa;
+		uint8_t shift;
+	} percentage_factor_t;
+
+	/**
+	 * @brief Works out (float)percentage / 100.0f exactly, in integers:
+	 *        round-to-nearest-even to 24 significant bits.
+	 *
+	 * @param percentage_value 1..255
+	 * @return Mantissa and shift of the rounded quotient
+	 */
+	static inline LCD_UI_CONSTEXPR percentage_factor_t make_percentage_factor(uint8_t percentage_value)
+	{
+		percentage_factor_t factor = {0U, 0U};
+		uint32_t numerator = 0U;
+		uint32_t remainder = 0U;
+
+		/* Normalise so the quotient lands in [2^23, 2^24); 255 needs 22 */
+		factor.shift = 22U;
+		while (((uint32_t)percentage_value << factor.shift) < (100UL << 23))
+		{
+			++factor.shift;
+		}
+
+		numerator = (uint32_t)percentage_value << factor.shift;
+		factor.mantissa = numerator / 100U;
+		remainder = numerator % 100U;
+
+		if ((remainder > 50U) || ((remainder == 50U) && (factor.mantissa & 1U)))
+		{
+			++factor.mantissa;
+		}
+
+		if (factor.mantissa == (1UL << 24))
+		{
+			factor.mantissa >>= 1;
+			--factor.shift;
+		}
+
+		return factor;
+	}
+
+	/**
+	 * @brief Multiplies one channel by a percentage factor, reproducing
+	 *        (int)((float)channel * factor) bit for bit. The FPU rounds
+	 *        the product to 24 significant bits, dropping @c excess low
+	 *        bits. As excess is below the shift, that rounding only
+	 *        changes the truncated result when it carries into the
+	 *        integer part, which adding half of the dropped range does
+	 *        as well (ties carry too, since the multiple of 2^shift is
+	 *        even). The result is saturated to 255.
+	 *
+	 * @param channel_value 0..255
+	 * @param factor        From make_percentage_factor()
+	 * @return Scaled channel
+	 */
+	static inline LCD_UI_CONSTEXPR uint8_t scale_channel_by_percentage_factor(uint8_t channel_value,
+										  percentage_factor_t factor)
+	{
+		uint32_t product = (uint32_t)channel_value * factor.mantissa;
+		const uint32_t high = product >> 24;
+
+		/* Bits past the 24th; comparisons rather than a loop, so no branches */
+		const uint32_t excess = (uint32_t)(high >= 1U) + (uint32_t)(high >= 2U) +
+					(uint32_t)(high >= 4U) + (uint32_t)(high >= 8U) +
+					(uint32_t)(high >= 16U) + (uint32_t)(high >= 32U) +
+					(uint32_t)(high >= 64U) + (uint32_t)(high >= 128U);
+
+		product += (1UL << excess) >> 1;
+		product >>= factor.shift;
+		return (uint8_t)((product > 255U) ? 255U : product);
+	}
+
 	/**
 	 * @brief Similar to LaTeX '!XX' syntax. Percentage <100 => darker,
 	 *        >100 => lighter, ==100 => unchanged.
 	 *
+	 *        Integer only, with results identical to
+	 *        scale_colour_by_factor(argb_value, percentage_value / 100.0f).
+	 *
 	 * @param argb_value        32-bit ARGB colour
 	 * @param percentage_value  0..200 typical
 	 * @return Adjusted 32-bit ARGB colour
 	 */
-	static inline uint32_t scale_colour_by_percentage(uint32_t argb_value,
-							  uint8_t percentage_value)
+	static inline LCD_UI_CONSTEXPR uint32_t scale_colour_by_percentage(uint32_t argb_value,
+									   uint8_t percentage_value)
 	{
-		float factor;
-		factor = (float)percentage_value / 100.0f;
-		return scale_colour_by_factor(argb_value, factor);
+		if (percentage_value == 0U)
+		{
+			return argb_value & 0xFF000000U;
+		}
+
+		const percentage_factor_t factor = make_percentage_factor(percentage_value);
+		return make_argb_colour(
+		    (uint8_t)(argb_value >> 24),
+		    scale_channel_by_percentage_factor((uint8_t)(argb_value >> 16), factor),
+		    scale_channel_by_percentage_factor((uint8_t)(argb_value >> 8), factor),
+		    scale_channel_by_percentage_factor((uint8_t)argb_value, factor));
+	}
+
+	/**
+	 * @brief Scales a run of colours by one percentage. The channel mapping
+	 *        is computed once into a 256-entry table, leaving three lookups
+	 *        per pixel. Results match scale_colour_by_percentage().
+	 *
+	 * @param source_colours      Input ARGB colours
+	 * @param destination_colours Output ARGB colours, may equal the input
+	 * @param colour_count        Number of colours
+	 * @param percentage_value    0..255
+	 */
+	static inline void scale_colours_by_percentage(const uint32_t *source_colours,
+						       uint32_t *destination_colours,
+						       size_t colour_count,
+						       uint8_t percentage_value)
+	{
+		uint8_t channel_table[256];
+		size_t index;
+
+		if (percentage_value == 0U)
+		{
+			for (index = 0U; index < 256U; ++index)
+			{
+				channel_table[index] = 0U;
+			}
+		}
+		else
+		{
+			percentage_factor_t factor = make_percentage_factor(percentage_value);
+			for (index = 0U; index < 256U; ++index)
+			{
+				channel_table[index] = scale_channel_by_percentage_factor((uint8_t)index, factor);
+			}
+		}
+
+		for (index = 0U; index < colour_count; ++index)
+		{
+			uint32_t colour = source_colours[index];
+			destination_colours[index] =
+			    (colour & 0xFF000000U) |
+			    ((uint32_t)channel_table[(colour >> 16) & 0xFFU] << 16) |
+			    ((uint32_t)channel_table[(colour >> 8) & 0xFFU] << 8) |
+			    (uint32_t)channel_table[colour & 0xFFU];
+		}
+	}
+
+	/**
+	 * @brief Scales a run of colours by a Q8.8 factor, two channels per
+	 *        32-bit operation (red and blue share one word, green and
+	 *        alpha another). With the DSP extension, factors above 256
+	 *        saturate with one UQADD8 instead. Results match
+	 *        scale_colour_by_q8().
+	 *
+	 * @param source_colours      Input ARGB colours
+	 * @param destination_colours Output ARGB colours, may equal the input
+	 * @param colour_count        Number of colours
+	 * @param factor_q8           0 => black, 256 => no change, 512 => double;
+	 *                            above 512 each colour goes through
+	 *                            scale_colour_by_q8()
+	 */
+	static inline void scale_colours_by_q8(const uint32_t *source_colours,
+					       uint32_t *destination_colours,
+					       size_t colour_count,
+					       uint16_t factor_q8)
+	{
+		/* Above 1.0 the lanes would overflow: split as c + c * extra */
+		const uint32_t base = (factor_q8 > 256U) ? 256U : factor_q8;
+		const uint32_t extra = (factor_q8 > 256U) ? (factor_q8 - 256U) : 0U;
+		size_t index;
+
+		/* Past double, c * extra no longer fits a 16-bit lane */
+		if (factor_q8 > 512U)
+		{
+			for (index = 0U; index < colour_count; ++index)
+			{
+				destination_colours[index] = scale_colour_by_q8(source_colours[index], factor_q8);
+			}
+			return;
+		}
+
+#if defined(__ARM_FEATURE_DSP)
+		/* Above 1.0, one UQADD8 adds c * extra and saturates all three channels */
+		if (extra != 0U)
+		{
+			for (index = 0U; index < colour_count; ++index)
+			{
+				const uint32_t colour = source_colours[index];
+				const uint32_t gained = ((((colour & 0x00FF00FFU) * extra) >> 8) & 0x00FF00FFU) |
+							((((colour & 0x0000FF00U) * extra) >> 8) & 0x0000FF00U);
+
+				destination_colours[index] = __UQADD8(colour, gained);
+			}
+			return;
+		}
+#endif
+
+		for (index = 0U; index < colour_count; ++index)
+		{
+			const uint32_t colour = source_colours[index];
+			const uint32_t red_blue = colour & 0x00FF00FFU;
+			const uint32_t green = (colour >> 8) & 0x000000FFU;
+			uint32_t scaled_red_blue;
+			uint32_t scaled_green;
+			uint32_t overflow;
+
+			if (extra == 0U)
+			{
+				scaled_red_blue = ((red_blue * base) >> 8) & 0x00FF00FFU;
+				scaled_green = (green * base) >> 8;
+			}
+			else
+			{
+				/* Each 16-bit lane stays below 512, so bit 8 flags overflow */
+				scaled_red_blue = red_blue + (((red_blue * extra) >> 8) & 0x00FF00FFU);
+				overflow = (scaled_red_blue >> 8) & 0x00010001U;
+				scaled_red_blue = (scaled_red_blue | (overflow * 0xFFU)) & 0x00FF00FFU;
+
+				scaled_green = green + ((green * extra) >> 8);
+				scaled_green = (scaled_green > 255U) ? 255U : scaled_green;
+			}
+
+			destination_colours[index] = (colour & 0xFF000000U) |
+						     scaled_red_blue |
+						     (scaled_green << 8);
+		}
 	}
 
 	/**
@@ -159,10 +416,10 @@ extern "C"
 	 * @param amount_value 0..100 -> how many percent to reduce from 100
 	 * @return Darkened colour
 	 */
-	static inline uint32_t darken_colour(uint32_t argb_value,
-					     uint8_t amount_value)
+	static inline LCD_UI_CONSTEXPR uint32_t darken_colour(uint32_t argb_value,
+							      uint8_t amount_value)
 	{
-		uint8_t target_percentage;
+		uint8_t target_percentage = 0U;
 		if (amount_value > 100U)
 		{
 			amount_value = 100U;
@@ -178,11 +435,10 @@ extern "C"
 	 * @param amount_value 0..100 -> how many percent to add above 100
 	 * @return Lightened colour
 	 */
-	static inline uint32_t lighten_colour(uint32_t argb_value,
-					      uint8_t amount_value)
+	static inline LCD_UI_CONSTEXPR uint32_t lighten_colour(uint32_t argb_value,
+							       uint8_t amount_value)
 	{
-		uint16_t total;
-		total = (uint16_t)(100U + amount_value);
+		uint16_t total = (uint16_t)(100U + amount_value);
 		if (total > 200U)
 		{
 			total = 200U;
@@ -190,6 +446,413 @@ extern "C"
 		return scale_colour_by_percentage(argb_value, (uint8_t)total);
 	}
 
+	/**
+	 * @brief Mixes two colours, all four channels, with rounding.
+	 *
+	 * @param foreground_value 32-bit ARGB colour at alpha 255
+	 * @param background_value 32-bit ARGB colour at alpha 0
+	 * @param alpha_value      0..255 weight of the foreground
+	 * @return Blended 32-bit ARGB colour
+	 */
+	static inline LCD_UI_CONSTEXPR uint32_t blend_colours(uint32_t foreground_value,
+							      uint32_t background_value,
+							      uint8_t alpha_value)
+	{
+		uint32_t result = 0U;
+		uint8_t shift = 0U;
+
+		for (shift = 0U; shift < 32U; shift = (uint8_t)(shift + 8U))
+		{
+			const uint32_t foreground_channel = (foreground_value >> shift) & 0xFFU;
+			const uint32_t background_channel = (background_value >> shift) & 0xFFU;
+			const uint32_t channel = (foreground_channel * alpha_value +
+						  background_channel * (255U - alpha_value) + 127U) /
+						 255U;
+			result |= channel << shift;
+		}
+
+		return result;
+	}
+
+	/*
+	 * Compile-time forms for C, where a static const initialiser cannot
+	 * call a function. Each expands to a constant expression matching the
+	 * function of the same meaning bit for bit, so palettes can be built
+	 * into flash. Arguments are evaluated more than once; pass constants.
+	 */
+
+	/**
+	 * @brief Constant form of make_argb_colour().
+	 */
+#define LCD_UI_ARGB(alpha_value, red_value, green_value, blue_value) \
+	((((uint32_t)(alpha_value) & 0xFFU) << 24) |                 \
+	 (((uint32_t)(red_value) & 0xFFU) << 16) |                   \
+	 (((uint32_t)(green_value) & 0xFFU) << 8) |                  \
+	 ((uint32_t)(blue_value) & 0xFFU))
+
+/* One channel scaled as scale_colour_by_factor() does it, saturated */
+#define LCD_UI_SCALE_CHANNEL_(channel_value, percentage_value)                              \
+	(((uint32_t)((float)(channel_value) * (float)((float)(percentage_value) / 100.0f)) > 255U) \
+	     ? 255U                                                                            \
+	     : (uint32_t)((float)(channel_value) * (float)((float)(percentage_value) / 100.0f)))
+
+	/**
+	 * @brief Constant form of scale_colour_by_percentage().
+	 */
+#define LCD_UI_SCALE_PERCENT(argb_value, percentage_value)                                   \
+	(((uint32_t)(argb_value) & 0xFF000000U) |                                            \
+	 (LCD_UI_SCALE_CHANNEL_(((uint32_t)(argb_value) >> 16) & 0xFFU, percentage_value) << 16) | \
+	 (LCD_UI_SCALE_CHANNEL_(((uint32_t)(argb_value) >> 8) & 0xFFU, percentage_value) << 8) |   \
+	 LCD_UI_SCALE_CHANNEL_((uint32_t)(argb_value) & 0xFFU, percentage_value))
+
+	/**
+	 * @brief Constant form of darken_colour().
+	 */
+#define LCD_UI_DARKEN(argb_value, amount_value) \
+	LCD_UI_SCALE_PERCENT(argb_value, ((amount_value) > 100U) ? 0U : (100U - (amount_value)))
+
+	/**
+	 * @brief Constant form of lighten_colour().
+	 */
+#define LCD_UI_LIGHTEN(argb_value, amount_value) \
+	LCD_UI_SCALE_PERCENT(argb_value, ((amount_value) > 100U) ? 200U : (100U + (amount_value)))
+
+/* One channel of blend_colours() */
+#define LCD_UI_BLEND_CHANNEL_(foreground_value, background_value, alpha_value, shift) \
+	((((((uint32_t)(foreground_value) >> (shift)) & 0xFFU) * (uint32_t)(alpha_value) +  \
+	   (((uint32_t)(background_value) >> (shift)) & 0xFFU) * (255U - (uint32_t)(alpha_value)) + 127U) / \
+	  255U)                                                                             \
+	 << (shift))
+
+	/**
+	 * @brief Constant form of blend_colours().
+	 */
+#define LCD_UI_BLEND(foreground_value, background_value, alpha_value)             \
+	(LCD_UI_BLEND_CHANNEL_(foreground_value, background_value, alpha_value, 24) | \
+	 LCD_UI_BLEND_CHANNEL_(foreground_value, background_value, alpha_value, 16) | \
+	 LCD_UI_BLEND_CHANNEL_(foreground_value, background_value, alpha_value, 8) |  \
+	 LCD_UI_BLEND_CHANNEL_(foreground_value, background_value, alpha_value, 0))
+
+	/**
+	 * @brief Shades derived from a background and text colour pair, kept
+	 *        in each widget style so they are not derived at draw time.
+	 *        Build it with LCD_UI_PALETTE() to keep it in flash.
+	 */
+	typedef struct lcd_ui_palette_t
+	{
+		uint32_t accent;   /* slider knob: text lightened by 40 */
+		uint32_t pressed;  /* pressed button face: background darkened by 20 */
+		uint32_t disabled; /* greyed text: text half-blended into background */
+		uint32_t focused;  /* focus highlight: background lightened by 20 */
+	} lcd_ui_palette_t;
+
+	/**
+	 * @brief Constant initialiser for an lcd_ui_palette_t, giving the same
+	 *        shades the library derives at runtime.
+	 */
+#define LCD_UI_PALETTE(background_value, text_value)            \
+	{                                                       \
+		LCD_UI_LIGHTEN(text_value, 40U),                \
+		LCD_UI_DARKEN(background_value, 20U),           \
+		LCD_UI_BLEND(text_value, background_value, 128U), \
+		LCD_UI_LIGHTEN(background_value, 20U)           \
+	}
+
+	/*
+	 * Pixel format conversion. The single-pixel functions are the
+	 * reference; the run converters give identical results. RGB888 runs
+	 * move four pixels per three 32-bit stores (little-endian, as on
+	 * Cortex-M).
+	 *
+	 * RGB888 is stored blue, green, red in memory, as the LTDC reads it.
+	 */
+
+#ifndef LCD_UI_PAIR_RGB565
+/*
+ * Whether RGB565 runs move two pixels per 32-bit access. Cores whose only
+ * SIMD is the DSP extension, such as the Cortex-M4 and M7, gain from it;
+ * elsewhere plain loops are left for the compiler to vectorise.
+ */
+#if defined(__ARM_FEATURE_DSP) && !defined(__ARM_FEATURE_MVE)
+#define LCD_UI_PAIR_RGB565 1
+#else
+#define LCD_UI_PAIR_RGB565 0
+#endif
+#endif
+
+	/**
+	 * @brief Packs an ARGB colour into RGB565 by truncation, dropping alpha.
+	 */
+	static inline LCD_UI_CONSTEXPR uint16_t argb_to_rgb565(uint32_t argb_value)
+	{
+		return (uint16_t)(((argb_value >> 8) & 0xF800U) |
+				  ((argb_value >> 5) & 0x07E0U) |
+				  ((argb_value >> 3) & 0x001FU));
+	}
+
+	/**
+	 * @brief Expands RGB565 to opaque ARGB, replicating the high bits so
+	 *        full scale maps to 255.
+	 */
+	static inline LCD_UI_CONSTEXPR uint32_t rgb565_to_argb(uint16_t rgb565_value)
+	{
+		const uint32_t red = ((uint32_t)rgb565_value >> 11) & 0x1FU;
+		const uint32_t green = ((uint32_t)rgb565_value >> 5) & 0x3FU;
+		const uint32_t blue = (uint32_t)rgb565_value & 0x1FU;
+
+		return 0xFF000000U |
+		       (((red << 3) | (red >> 2)) << 16) |
+		       (((green << 2) | (green >> 4)) << 8) |
+		       ((blue << 3) | (blue >> 2));
+	}
+
+	/**
+	 * @brief Rec. 601 luma of an ARGB colour, dropping alpha.
+	 */
+	static inline LCD_UI_CONSTEXPR uint8_t argb_to_l8(uint32_t argb_value)
+	{
+		return (uint8_t)((((argb_value >> 16) & 0xFFU) * 77U +
+				  ((argb_value >> 8) & 0xFFU) * 150U +
+				  (argb_value & 0xFFU) * 29U + 128U) >>
+				 8);
+	}
+
+	/**
+	 * @brief Opaque grey from a luminance value.
+	 */
+	static inline LCD_UI_CONSTEXPR uint32_t l8_to_argb(uint8_t luminance_value)
+	{
+		return 0xFF000000U | ((uint32_t)luminance_value * 0x00010101U);
+	}
+
+	/**
+	 * @brief 4x4 Bayer threshold for ordered dithering, 0..15.
+	 */
+	static inline LCD_UI_CONSTEXPR uint8_t bayer_threshold(uint16_t x, uint16_t y)
+	{
+		return (uint8_t)((0x5D7F91B36E4CA280ULL >> (((y & 3U) * 16U) + ((x & 3U) * 4U))) & 0xFU);
+	}
+
+	/**
+	 * @brief Packs an ARGB colour into RGB565 with ordered dithering, so
+	 *        smooth gradients do not band. The same (x, y) always gets
+	 *        the same result, keeping partial redraws seamless.
+	 *
+	 * @param argb_value 32-bit ARGB colour
+	 * @param x          Pixel column on screen
+	 * @param y          Pixel row on screen
+	 * @return RGB565 colour
+	 */
+	static inline LCD_UI_CONSTEXPR uint16_t argb_to_rgb565_dithered(uint32_t argb_value,
+									uint16_t x,
+									uint16_t y)
+	{
+		const uint32_t threshold = bayer_threshold(x, y);
+		uint32_t red = ((argb_value >> 16) & 0xFFU) + (threshold >> 1);
+		uint32_t green = ((argb_value >> 8) & 0xFFU) + (threshold >> 2);
+		uint32_t blue = (argb_value & 0xFFU) + (threshold >> 1);
+
+		red = (red > 255U) ? 255U : red;
+		green = (green > 255U) ? 255U : green;
+		blue = (blue > 255U) ? 255U : blue;
+
+		return (uint16_t)(((red & 0xF8U) << 8) | ((green & 0xFCU) << 3) | (blue >> 3));
+	}
+
+	/**
+	 * @brief Converts a run of ARGB8888 pixels to RGB565.
+	 *
+	 * @param source_pixels      ARGB8888 input
+	 * @param destination_pixels RGB565 output
+	 * @param pixel_count        Number of pixels
+	 */
+	static inline void convert_argb_to_rgb565(const uint32_t *source_pixels,
+						  uint16_t *destination_pixels,
+						  size_t pixel_count)
+	{
+		size_t index = 0U;
+
+#if LCD_UI_PAIR_RGB565
+		/* Align the output, then store two pixels per word */
+		if ((pixel_count > 0U) && (((uintptr_t)destination_pixels & 2U) != 0U))
+		{
+			destination_pixels[0] = argb_to_rgb565(source_pixels[0]);
+			index = 1U;
+		}
+
+		for (; index + 2U <= pixel_count; index += 2U)
+		{
+			const uint32_t pair = (uint32_t)argb_to_rgb565(source_pixels[index]) |
+					      ((uint32_t)argb_to_rgb565(source_pixels[index + 1U]) << 16);
+			memcpy(&destination_pixels[index], &pair, sizeof(pair));
+		}
+#endif
+
+		for (; index < pixel_count; ++index)
+		{
+			destination_pixels[index] = argb_to_rgb565(source_pixels[index]);
+		}
+	}
+
+	/**
+	 * @brief Converts a run of ARGB8888 pixels to dithered RGB565. The run
+	 *        is taken to start at screen position (x, y) and go rightwards.
+	 *
+	 * @param source_pixels      ARGB8888 input
+	 * @param destination_pixels RGB565 output
+	 * @param pixel_count        Number of pixels
+	 * @param x                  Screen column of the first pixel
+	 * @param y                  Screen row of the run
+	 */
+	static inline void convert_argb_to_rgb565_dithered(const uint32_t *source_pixels,
+							   uint16_t *destination_pixels,
+							   size_t pixel_count,
+							   uint16_t x,
+							   uint16_t y)
+	{
+		size_t index;
+
+		for (index = 0U; index < pixel_count; ++index)
+		{
+			destination_pixels[index] =
+			    argb_to_rgb565_dithered(source_pixels[index], (uint16_t)(x + index), y);
+		}
+	}
+
+	/**
+	 * @brief Converts a run of RGB565 pixels to opaque ARGB8888.
+	 *
+	 * @param source_pixels      RGB565 input
+	 * @param destination_pixels ARGB8888 output
+	 * @param pixel_count        Number of pixels
+	 */
+	static inline void convert_rgb565_to_argb(const uint16_t *source_pixels,
+						  uint32_t *destination_pixels,
+						  size_t pixel_count)
+	{
+		size_t index = 0U;
+
+#if LCD_UI_PAIR_RGB565
+		if ((pixel_count > 0U) && (((uintptr_t)source_pixels & 2U) != 0U))
+		{
+			destination_pixels[0] = rgb565_to_argb(source_pixels[0]);
+			index = 1U;
+		}
+
+		/* Load two pixels per word */
+		for (; index + 2U <= pixel_count; index += 2U)
+		{
+			uint32_t pair;
+			memcpy(&pair, &source_pixels[index], sizeof(pair));
+			destination_pixels[index] = rgb565_to_argb((uint16_t)pair);
+			destination_pixels[index + 1U] = rgb565_to_argb((uint16_t)(pair >> 16));
+		}
+#endif
+
+		for (; index < pixel_count; ++index)
+		{
+			destination_pixels[index] = rgb565_to_argb(source_pixels[index]);
+		}
+	}
+
+	/**
+	 * @brief Converts a run of ARGB8888 pixels to packed RGB888.
+	 *
+	 * @param source_pixels      ARGB8888 input
+	 * @param destination_bytes  3 * pixel_count bytes of output
+	 * @param pixel_count        Number of pixels
+	 */
+	static inline void convert_argb_to_rgb888(const uint32_t *source_pixels,
+						  uint8_t *destination_bytes,
+						  size_t pixel_count)
+	{
+		size_t index = 0U;
+
+		/* Four pixels fill exactly three words */
+		for (; index + 4U <= pixel_count; index += 4U)
+		{
+			const uint32_t p0 = source_pixels[index] & 0x00FFFFFFU;
+			const uint32_t p1 = source_pixels[index + 1U] & 0x00FFFFFFU;
+			const uint32_t p2 = source_pixels[index + 2U] & 0x00FFFFFFU;
+			const uint32_t p3 = source_pixels[index + 3U] & 0x00FFFFFFU;
+			const uint32_t words[3] = {p0 | (p1 << 24),
+						   (p1 >> 8) | (p2 << 16),
+						   (p2 >> 16) | (p3 << 8)};
+
+			memcpy(destination_bytes + index * 3U, words, sizeof(words));
+		}
+
+		for (; index < pixel_count; ++index)
+		{
+			const uint32_t pixel = source_pixels[index];
+			uint8_t *out = destination_bytes + index * 3U;
+			out[0] = (uint8_t)pixel;
+			out[1] = (uint8_t)(pixel >> 8);
+			out[2] = (uint8_t)(pixel >> 16);
+		}
+	}
+
+	/**
+	 * @brief Converts a run of packed RGB888 pixels to opaque ARGB8888.
+	 *
+	 * @param source_bytes       3 * pixel_count bytes of input
+	 * @param destination_pixels ARGB8888 output
+	 * @param pixel_count        Number of pixels
+	 */
+	static inline void convert_rgb888_to_argb(const uint8_t *source_bytes,
+						  uint32_t *destination_pixels,
+						  size_t pixel_count)
+	{
+		size_t index;
+
+		for (index = 0U; index < pixel_count; ++index)
+		{
+			const uint8_t *in = source_bytes + index * 3U;
+			destination_pixels[index] = 0xFF000000U |
+						    ((uint32_t)in[2] << 16) |
+						    ((uint32_t)in[1] << 8) |
+						    (uint32_t)in[0];
+		}
+	}
+
+	/**
+	 * @brief Converts a run of ARGB8888 pixels to 8-bit luminance.
+	 *
+	 * @param source_pixels      ARGB8888 input
+	 * @param destination_pixels L8 output
+	 * @param pixel_count        Number of pixels
+	 */
+	static inline void convert_argb_to_l8(const uint32_t *source_pixels,
+					      uint8_t *destination_pixels,
+					      size_t pixel_count)
+	{
+		size_t index;
+
+		for (index = 0U; index < pixel_count; ++index)
+		{
+			destination_pixels[index] = argb_to_l8(source_pixels[index]);
+		}
+	}
+
+	/**
+	 * @brief Converts a run of 8-bit luminance pixels to opaque ARGB8888.
+	 *
+	 * @param source_pixels      L8 input
+	 * @param destination_pixels ARGB8888 output
+	 * @param pixel_count        Number of pixels
+	 */
+	static inline void convert_l8_to_argb(const uint8_t *source_pixels,
+					      uint32_t *destination_pixels,
+					      size_t pixel_count)
+	{
+		size_t index;
+
+		for (index = 0U; index < pixel_count; ++index)
+		{
+			destination_pixels[index] = l8_to_argb(source_pixels[index]);
+		}
+	}
+
 	/*
 	 * Below are standard named colours as static constants.
 	 * They are fully opaque with alpha=255.
@@ -0,0 +1,149 @@
+/**
+ * @file        lcd_ui_decimate.h
+ * @brief       Min/max pyramid for plotting long series at pixel resolution.
+ *
+ * @author      Ryan Hicks <c3361231@uon.edu.au>
+ *              School of Engineering (Electrical and Computer Engineering)
+ *              University of Newcastle
+ *
+ * @date        2025-04-11
+ * @version     1.0.0
+ *
+ * @copyright   Copyright (c) 2025 Ryan
+ * @license     SPDX-License-Identifier: MIT
+ *
+ * @note        Redistribution and use permitted with attribution.
+ */
+
+#ifndef LCD_UI_DECIMATE_H
+#define LCD_UI_DECIMATE_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+
+#include "lcd_ui_samples.h"
+
+#ifndef LCD_UI_PYRAMID_SHIFT
+/**
+ * @brief log2 of the pyramid fan-out. 3 (eight children per node) keeps
+ *        the node storage near one seventh of the sample count.
+ */
+#define LCD_UI_PYRAMID_SHIFT 3U
+#endif
+
+/**
+ * @brief Deepest pyramid a 32-bit sample count can need.
+ */
+#define LCD_UI_PYRAMID_MAX_LEVELS ((32U + LCD_UI_PYRAMID_SHIFT - 1U) / LCD_UI_PYRAMID_SHIFT)
+
+	/**
+	 * @brief Extremes of a run of samples.
+	 */
+	typedef struct
+	{
+		int32_t minimum;
+		int32_t maximum;
+	} lcd_ui_minmax_t;
+
+	/**
+	 * @brief Append-only series with precomputed min/max per block at
+	 *        each level, so the extremes of any range cost O(levels).
+	 *        Both arrays are caller-owned.
+	 */
+	typedef struct
+	{
+		lcd_ui_samples_t source; /* where samples are read from */
+		int32_t *samples;        /* append storage, NULL for a read-only source */
+		uint32_t capacity;
+		uint32_t count;
+
+		lcd_ui_minmax_t *nodes;
+		uint8_t levels; /* node levels above the samples */
+		uint32_t level_offset[LCD_UI_PYRAMID_MAX_LEVELS + 1U];
+	} lcd_ui_pyramid_t;
+
+	/**
+	 * @brief Number of lcd_ui_minmax_t nodes a pyramid over @p capacity
+	 *        samples needs.
+	 */
+	uint32_t lcd_ui_pyramid_nodes_needed(uint32_t capacity);
+
+	/**
+	 * @brief Prepares an empty pyramid.
+	 * @param pyramid    Pyramid to initialise
+	 * @param samples    Sample storage, @p capacity entries
+	 * @param capacity   Maximum number of samples
+	 * @param nodes      Node storage
+	 * @param node_count Entries in @p nodes, see lcd_ui_pyramid_nodes_needed()
+	 * @return 0 if @p nodes is too small
+	 */
+	uint8_t lcd_ui_pyramid_init(lcd_ui_pyramid_t *pyramid,
+				    int32_t *samples, uint32_t capacity,
+				    lcd_ui_minmax_t *nodes, uint32_t node_count);
+
+	/**
+	 * @brief Prepares an empty pyramid over samples the caller writes in
+	 *        place, such as a DMA acquisition record of any sample type.
+	 *        Announce each completed stretch with lcd_ui_pyramid_extend();
+	 *        lcd_ui_pyramid_append() is not available.
+	 * @param pyramid    Pyramid to initialise
+	 * @param source     Sample buffer descriptor, copied
+	 * @param capacity   Maximum number of samples
+	 * @param nodes      Node storage
+	 * @param node_count Entries in @p nodes, see lcd_ui_pyramid_nodes_needed()
+	 * @return 0 if @p nodes is too small
+	 */
+	uint8_t lcd_ui_pyramid_init_source(lcd_ui_pyramid_t *pyramid,
+					   const lcd_ui_samples_t *source, uint32_t capacity,
+					   lcd_ui_minmax_t *nodes, uint32_t node_count);
+
+	/**
+	 * @brief Copies samples onto the end of the series and updates the
+	 *        nodes above them. Samples past capacity are dropped. Only
+	 *        for pyramids set up with lcd_ui_pyramid_init().
+	 * @param pyramid Pyramid to extend
+	 * @param samples New samples
+	 * @param count   Number of new samples
+	 */
+	void lcd_ui_pyramid_append(lcd_ui_pyramid_t *pyramid,
+				   const int32_t *samples, uint32_t count);
+
+	/**
+	 * @brief Takes in @p count samples already written in place after
+	 *        the current end, e.g. by DMA, without copying them.
+	 * @param pyramid Pyramid to extend
+	 * @param count   Number of new samples
+	 */
+	void lcd_ui_pyramid_extend(lcd_ui_pyramid_t *pyramid, uint32_t count);
+
+	/**
+	 * @brief Extremes of samples [start, end). The range must be
+	 *        non-empty and inside the series.
+	 */
+	lcd_ui_minmax_t lcd_ui_pyramid_range(const lcd_ui_pyramid_t *pyramid,
+					     uint32_t start, uint32_t end);
+
+	/**
+	 * @brief Per-column min/max envelope of @p length samples from
+	 *        @p start spread over @p columns. Costs O(columns * levels)
+	 *        however many samples are covered. Columns narrower than a
+	 *        sample show the sample under them.
+	 * @param pyramid   Pyramid to read
+	 * @param start     First sample of the window
+	 * @param length    Samples in the window, clipped to the series
+	 * @param columns   Number of columns
+	 * @param envelope  Receives @p columns entries
+	 */
+	void lcd_ui_pyramid_envelope(const lcd_ui_pyramid_t *pyramid,
+				     uint32_t start, uint32_t length,
+				     uint16_t columns, lcd_ui_minmax_t *envelope);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LCD_UI_DECIMATE_H */
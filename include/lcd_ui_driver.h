@@ -26,10 +26,31 @@ extern "C"
 #endif
 
         /**
-         * @brief BSP-specific driver instance for STM32H747I-DISCO LCD.
+         * @brief Per-panel state handed to every BSP driver callback.
+         */
+        typedef struct
+        {
+                uint32_t lcd_instance;         /* BSP_LCD instance number */
+                uint32_t layer;                /* LTDC layer drawn into */
+                uint32_t front_buffer_address; /* Scanned out when double buffered */
+                uint32_t back_buffer_address;  /* Drawn into when double buffered */
+                uint32_t time_cycles;          /* DWT count last carried into time_us */
+                uint32_t time_us;              /* Running get_time_us() result */
+        } lcd_ui_bsp_instance_t;
+
+        /**
+         * @brief BSP-specific driver for STM32H747I-DISCO LCD. It draws
+         *        through the UTIL_LCD globals (layer, colours, font) and the
+         *        shared DMA2D and LTDC handles, so all its instances must be
+         *        driven from one task, or every call on them serialised.
          */
         extern const lcd_ui_driver_t lcd_ui_bsp_driver;
 
+        /**
+         * @brief Default instance for the on-board panel, layer 0.
+         */
+        extern lcd_ui_bsp_instance_t lcd_ui_bsp_instance;
+
 #ifdef __cplusplus
 }
 #endif
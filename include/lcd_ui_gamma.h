@@ -0,0 +1,147 @@
+/**
+ * @file        lcd_ui_gamma.h
+ * @brief       sRGB <-> linear-light lookup tables and gamma-correct blending.
+ *
+ * @author      Ryan Hicks <c3361231@uon.edu.au>
+ *              School of Engineering (Electrical and Computer Engineering)
+ *              University of Newcastle
+ *
+ * @date        2025-04-11
+ * @version     1.0.0
+ *
+ * @copyright   Copyright (c) 2025 Ryan
+ * @license     SPDX-License-Identifier: MIT
+ *
+ * @note        Redistribution and use permitted with attribution.
+ */
+
+#ifndef LCD_UI_GAMMA_H
+#define LCD_UI_GAMMA_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * By default the tables are constant data in flash. Define
+ * LCD_UI_GAMMA_RAM_TABLES to build them in RAM with lcd_ui_gamma_init()
+ * instead, trading 4.5 KiB of RAM and a start-up cost for the flash.
+ */
+#ifdef LCD_UI_GAMMA_RAM_TABLES
+#define LCD_UI_GAMMA_TABLE
+#else
+#define LCD_UI_GAMMA_TABLE const
+#endif
+
+/**
+ * @brief Bits of precision in the linear-light domain.
+ */
+#define LCD_UI_LINEAR_BITS 12U
+#define LCD_UI_LINEAR_MAX ((1U << LCD_UI_LINEAR_BITS) - 1U)
+
+	/**
+	 * @brief sRGB channel (0..255) to linear light (0..LCD_UI_LINEAR_MAX).
+	 */
+	extern LCD_UI_GAMMA_TABLE uint16_t lcd_ui_srgb_to_linear[256];
+
+	/**
+	 * @brief Linear light (0..LCD_UI_LINEAR_MAX) to sRGB channel, rounded.
+	 *        Round-trips every sRGB value exactly.
+	 */
+	extern LCD_UI_GAMMA_TABLE uint8_t lcd_ui_linear_to_srgb[LCD_UI_LINEAR_MAX + 1U];
+
+	/**
+	 * @brief Fills the tables when LCD_UI_GAMMA_RAM_TABLES is defined; does
+	 *        nothing otherwise. Call once before blending.
+	 */
+	void lcd_ui_gamma_init(void);
+
+	/**
+	 * @brief Mixes two colours in linear light, so anti-aliased edges and
+	 *        translucent fills keep their brightness instead of going
+	 *        muddy. Alpha itself is mixed linearly.
+	 *
+	 * @param foreground_value 32-bit ARGB colour at alpha 255
+	 * @param background_value 32-bit ARGB colour at alpha 0
+	 * @param alpha_value      0..255 weight of the foreground
+	 * @return Blended 32-bit ARGB colour
+	 */
+	static inline uint32_t blend_colours_linear(uint32_t foreground_value,
+						    uint32_t background_value,
+						    uint8_t alpha_value)
+	{
+		const uint32_t inverse = 255U - alpha_value;
+		uint32_t result;
+		uint8_t shift;
+
+		if (alpha_value == 255U)
+			return foreground_value;
+		if (alpha_value == 0U)
+			return background_value;
+
+		result = ((((foreground_value >> 24) * alpha_value) +
+			   ((background_value >> 24) * inverse) + 127U) /
+			  255U)
+			 << 24;
+
+		for (shift = 0U; shift < 24U; shift = (uint8_t)(shift + 8U))
+		{
+			const uint32_t foreground = lcd_ui_srgb_to_linear[(foreground_value >> shift) & 0xFFU];
+			const uint32_t background = lcd_ui_srgb_to_linear[(background_value >> shift) & 0xFFU];
+			const uint32_t linear = (foreground * alpha_value + background * inverse + 127U) / 255U;
+			result |= (uint32_t)lcd_ui_linear_to_srgb[linear] << shift;
+		}
+
+		return result;
+	}
+
+	/**
+	 * @brief Blends one colour into a run of pixels with per-pixel
+	 *        coverage, as anti-aliased glyphs and edges need.
+	 *
+	 * @param colour_value  32-bit ARGB colour to lay down
+	 * @param coverage      0..255 weight per pixel
+	 * @param pixels        ARGB8888 pixels, blended in place
+	 * @param pixel_count   Number of pixels
+	 */
+	static inline void blend_span_linear(uint32_t colour_value,
+					     const uint8_t *coverage,
+					     uint32_t *pixels,
+					     size_t pixel_count)
+	{
+		const uint32_t red = lcd_ui_srgb_to_linear[(colour_value >> 16) & 0xFFU];
+		const uint32_t green = lcd_ui_srgb_to_linear[(colour_value >> 8) & 0xFFU];
+		const uint32_t blue = lcd_ui_srgb_to_linear[colour_value & 0xFFU];
+		size_t index;
+
+		for (index = 0U; index < pixel_count; ++index)
+		{
+			const uint32_t alpha = coverage[index];
+			const uint32_t inverse = 255U - alpha;
+			const uint32_t pixel = pixels[index];
+
+			if (alpha == 0U)
+				continue;
+			if (alpha == 255U)
+			{
+				pixels[index] = colour_value;
+				continue;
+			}
+
+			pixels[index] =
+			    (((((colour_value >> 24) * alpha) + ((pixel >> 24) * inverse) + 127U) / 255U) << 24) |
+			    ((uint32_t)lcd_ui_linear_to_srgb[(red * alpha + lcd_ui_srgb_to_linear[(pixel >> 16) & 0xFFU] * inverse + 127U) / 255U] << 16) |
+			    ((uint32_t)lcd_ui_linear_to_srgb[(green * alpha + lcd_ui_srgb_to_linear[(pixel >> 8) & 0xFFU] * inverse + 127U) / 255U] << 8) |
+			    (uint32_t)lcd_ui_linear_to_srgb[(blue * alpha + lcd_ui_srgb_to_linear[pixel & 0xFFU] * inverse + 127U) / 255U];
+		}
+	}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LCD_UI_GAMMA_H */
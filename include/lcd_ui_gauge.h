@@ -0,0 +1,98 @@
+/**
+ * @file        lcd_ui_gauge.h
+ * @brief       Circular gauge widget with a cached dial face.
+ *
+ * @author      Ryan Hicks <c3361231@uon.edu.au>
+ *              School of Engineering (Electrical and Computer Engineering)
+ *              University of Newcastle
+ *
+ * @date        2025-04-11
+ * @version     1.0.0
+ *
+ * @copyright   Copyright (c) 2025 Ryan
+ * @license     SPDX-License-Identifier: MIT
+ *
+ * @note        Redistribution and use permitted with attribution.
+ */
+
+#ifndef LCD_UI_GAUGE_H
+#define LCD_UI_GAUGE_H
+
+#include "lcd_ui.h"
+#include "lcd_ui_surface.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+
+	/**
+	 * @brief Gauge state, referenced by a LCD_UI_WIDGET_GAUGE widget's
+	 *        data pointer. The dial is the largest circle centred in the
+	 *        widget. Angles are in degrees, clockwise from 12 o'clock.
+	 *        The face (disc, ticks, labels) is drawn in the widget's
+	 *        colours; the needle in the style's accent shade.
+	 */
+	typedef struct
+	{
+		int32_t minimum;
+		int32_t maximum;
+		int32_t value;
+
+		int16_t start_angle; /* where minimum points */
+		int16_t sweep;       /* degrees from minimum to maximum */
+		uint8_t major_ticks; /* labelled intervals across the sweep */
+		uint8_t minor_ticks; /* unlabelled ticks per major interval */
+		uint8_t needle_width;
+
+		lcd_ui_surface_t face;
+		uint8_t face_cached; /* face registered with a surface cache */
+
+		/* Needle as last drawn, for repairing it on the next change */
+		lcd_ui_rect_t needle_box;
+		uint8_t needle_drawn;
+	} lcd_ui_gauge_t;
+
+	/**
+	 * @brief Prepares a gauge sweeping 270 degrees with 5 labelled
+	 *        intervals. Adjust the angles and ticks afterwards, before
+	 *        the first draw.
+	 * @param gauge   Gauge to initialise
+	 * @param cache   Surface cache for the dial face, or NULL to redraw
+	 *                the face every time
+	 * @param minimum Value at the start of the sweep
+	 * @param maximum Value at the end of the sweep, above @p minimum
+	 */
+	void lcd_ui_gauge_init(lcd_ui_gauge_t *gauge,
+			       lcd_ui_surface_cache_t *cache,
+			       int32_t minimum, int32_t maximum);
+
+	/**
+	 * @brief Moves the needle. Only the boxes around the old and new
+	 *        needle are repainted, from the cached face.
+	 * @param ctx    Pointer to initialized lcd_ui_context_t
+	 * @param widget Gauge widget
+	 * @param value  New value, clamped to the range
+	 */
+	void lcd_ui_gauge_set_value(lcd_ui_context_t *ctx, lcd_ui_widget_t *widget,
+				    int32_t value);
+
+	/**
+	 * @brief Draws the part of a gauge widget that lies in ctx->clip.
+	 *        Called by lcd_ui while drawing widgets.
+	 * @param ctx        Pointer to initialized lcd_ui_context_t
+	 * @param widget     Gauge widget
+	 * @param background Fill around the dial
+	 * @param foreground Tick and label colour
+	 */
+	void lcd_ui_gauge_draw(lcd_ui_context_t *ctx,
+			       const lcd_ui_widget_t *widget,
+			       uint32_t background, uint32_t foreground);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LCD_UI_GAUGE_H */
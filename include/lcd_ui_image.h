@@ -0,0 +1,118 @@
+/**
+ * @file        lcd_ui_image.h
+ * @brief       Raw and compressed image drawing with streaming decode.
+ *
+ * @author      Ryan Hicks <c3361231@uon.edu.au>
+ *              School of Engineering (Electrical and Computer Engineering)
+ *              University of Newcastle
+ *
+ * @date        2025-04-11
+ * @version     1.0.0
+ *
+ * @copyright   Copyright (c) 2025 Ryan
+ * @license     SPDX-License-Identifier: MIT
+ *
+ * @note        Redistribution and use permitted with attribution.
+ */
+
+#ifndef LCD_UI_IMAGE_H
+#define LCD_UI_IMAGE_H
+
+#include "lcd_ui.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+
+#ifndef LCD_UI_IMAGE_STRIP
+/**
+ * @brief Pixels decoded before each blit (4 bytes each, on the stack).
+ *        Images wider than this are drawn in several column bands.
+ */
+#define LCD_UI_IMAGE_STRIP 256U
+#endif
+
+	/**
+	 * @brief Image encodings.
+	 *
+	 * RLE565: packets of one header byte h. If h & 0x80, the next
+	 * little-endian RGB565 pixel repeats (h & 0x7F) + 1 times; otherwise
+	 * h + 1 literal RGB565 pixels follow. Packets never cross a restart
+	 * row.
+	 *
+	 * QOI: a standard QOI file, header included. Transparent pixels are
+	 * blended onto the background colour given when drawing. When
+	 * restart_interval is set, the encoder resets its state (previous
+	 * pixel, colour index, run) at the start of each restart row, so
+	 * decoding can start there.
+	 */
+	typedef enum
+	{
+		LCD_UI_IMAGE_ARGB8888 = 0, /* raw, blitted as is */
+		LCD_UI_IMAGE_RGB565,       /* raw, copied as is onto RGB565 targets */
+		LCD_UI_IMAGE_RLE565,
+		LCD_UI_IMAGE_QOI,
+	} lcd_ui_image_format_t;
+
+	/**
+	 * @brief An image in flash or RAM. Referenced by a LCD_UI_WIDGET_IMAGE
+	 *        widget's data pointer; drawn at the widget's top left, with
+	 *        the background colour filling any remainder.
+	 */
+	typedef struct
+	{
+		const void *data;
+		uint32_t size; /* bytes of data */
+		uint16_t width;
+		uint16_t height;
+		uint8_t format; /* lcd_ui_image_format_t */
+
+		/* Compressed only: rows between decoder restarts (0 for none)
+		   and the byte offset of each restart row, so a redraw that
+		   starts part way down skips straight there. */
+		uint16_t restart_interval;
+		const uint32_t *row_index;
+	} lcd_ui_image_t;
+
+	/**
+	 * @brief Fills in an image from a QOI file, reading its size from the
+	 *        header. Set restart_interval and row_index afterwards if the
+	 *        file was encoded with restarts.
+	 * @return 0 if @p data is not a QOI file
+	 */
+	uint8_t lcd_ui_image_init_qoi(lcd_ui_image_t *image, const void *data, uint32_t size);
+
+	/**
+	 * @brief Draws an image with its top left at logical (x, y), clipped
+	 *        to ctx->clip. Compressed images are decoded straight into
+	 *        the target a strip at a time; rows above the clip are
+	 *        skipped using the row index where there is one, and decoding
+	 *        stops below it.
+	 * @param ctx        Pointer to initialized lcd_ui_context_t
+	 * @param image      Image to draw
+	 * @param x          Left edge
+	 * @param y          Top edge
+	 * @param background Colour transparent pixels are blended onto
+	 */
+	void lcd_ui_image_draw_at(lcd_ui_context_t *ctx, const lcd_ui_image_t *image,
+				  uint16_t x, uint16_t y, uint32_t background);
+
+	/**
+	 * @brief Draws the part of an image widget that lies in ctx->clip.
+	 *        Called by lcd_ui while drawing widgets.
+	 * @param ctx        Pointer to initialized lcd_ui_context_t
+	 * @param widget     Image widget
+	 * @param background Fill around the image and under transparency
+	 */
+	void lcd_ui_image_draw(lcd_ui_context_t *ctx,
+			       const lcd_ui_widget_t *widget,
+			       uint32_t background);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LCD_UI_IMAGE_H */
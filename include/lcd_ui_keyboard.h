@@ -0,0 +1,153 @@
+/**
+ * @file        lcd_ui_keyboard.h
+ * @brief       On-screen keyboard widget with cached layouts.
+ *
+ * @author      Ryan Hicks <c3361231@uon.edu.au>
+ *              School of Engineering (Electrical and Computer Engineering)
+ *              University of Newcastle
+ *
+ * @date        2025-04-11
+ * @version     1.0.0
+ *
+ * @copyright   Copyright (c) 2025 Ryan
+ * @license     SPDX-License-Identifier: MIT
+ *
+ * @note        Redistribution and use permitted with attribution.
+ */
+
+#ifndef LCD_UI_KEYBOARD_H
+#define LCD_UI_KEYBOARD_H
+
+#include "lcd_ui.h"
+#include "lcd_ui_surface.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef LCD_UI_KEYBOARD_MAX_LAYOUTS
+/**
+ * @brief Layouts one keyboard can switch between, each with its own
+ *        cached surface.
+ */
+#define LCD_UI_KEYBOARD_MAX_LAYOUTS 4U
+#endif
+
+/* Key codes that are not characters */
+#define LCD_UI_KEY_GAP '\x01'       /* no key; the cell shows the background */
+#define LCD_UI_KEY_BACKSPACE '\b'   /* removes the last character */
+#define LCD_UI_KEY_ENTER '\r'       /* only fires on_touch */
+#define LCD_UI_KEY_LAYOUT(n) ((char)(0x10 + (n))) /* switches to layout n */
+
+	/**
+	 * @brief One arrangement of keys: row_count strings of exactly
+	 *        @c columns key codes each. All keys in a layout are the
+	 *        same size; repeating a code in neighbouring cells of a row
+	 *        makes one wider key, e.g. eight spaces for a space bar.
+	 */
+	typedef struct
+	{
+		const char *const *rows;
+		uint8_t row_count;
+		uint8_t columns;
+		const char *name; /* label of the keys switching to it, e.g. "123" */
+	} lcd_ui_keyboard_layout_t;
+
+	/**
+	 * @brief Keyboard state, referenced by a LCD_UI_WIDGET_KEYBOARD
+	 *        widget's data pointer. Keys are drawn in the style's focused
+	 *        shade, and the key under the finger in its pressed shade.
+	 *        A key is typed when the finger lifts off it; on_touch then
+	 *        fires with the code in @c key.
+	 */
+	typedef struct
+	{
+		const lcd_ui_keyboard_layout_t *layouts;
+		uint8_t layout_count;
+		uint8_t layout; /* shown now */
+
+		/* Typed text, caller-owned; NULL to only report keys */
+		char *text;
+		size_t text_size;
+		size_t length;
+
+		lcd_ui_surface_t faces[LCD_UI_KEYBOARD_MAX_LAYOUTS];
+		uint8_t faces_cached; /* faces registered with a surface cache */
+
+		/* Key under the finger, if any */
+		uint8_t pressed;
+		uint8_t pressed_row;
+		uint8_t pressed_column;
+
+		char key; /* last key typed */
+	} lcd_ui_keyboard_t;
+
+	/**
+	 * @brief Prepares a keyboard showing its first layout.
+	 * @param keyboard     Keyboard to initialise
+	 * @param cache        Surface cache for the idle layouts, or NULL to
+	 *                     draw every key each time
+	 * @param layouts      Layouts, usually const tables in flash
+	 * @param layout_count Number of layouts, up to LCD_UI_KEYBOARD_MAX_LAYOUTS
+	 * @param text         Buffer for typed text, or NULL
+	 * @param text_size    Size of @p text in bytes, terminator included
+	 */
+	void lcd_ui_keyboard_init(lcd_ui_keyboard_t *keyboard,
+				  lcd_ui_surface_cache_t *cache,
+				  const lcd_ui_keyboard_layout_t *layouts,
+				  uint8_t layout_count,
+				  char *text, size_t text_size);
+
+	/**
+	 * @brief Shows another layout. With a cache, a layout already seen
+	 *        is one blit; its text is not drawn again.
+	 */
+	void lcd_ui_keyboard_set_layout(lcd_ui_context_t *ctx, lcd_ui_widget_t *widget,
+					uint8_t layout);
+
+	/**
+	 * @brief Finds the key under a logical point by division.
+	 * @param widget Keyboard widget
+	 * @param x      Logical x
+	 * @param y      Logical y
+	 * @param row    Receives the row
+	 * @param column Receives the column
+	 * @return The key code, or 0 if the point is on no key
+	 */
+	char lcd_ui_keyboard_key_at(const lcd_ui_widget_t *widget,
+				    uint16_t x, uint16_t y,
+				    uint8_t *row, uint8_t *column);
+
+	/**
+	 * @brief Feeds a touch to the keyboard. Only the keys whose state
+	 *        changes are repainted. Called by lcd_ui_handle_touch().
+	 * @param ctx    Pointer to initialized lcd_ui_context_t
+	 * @param widget Keyboard widget
+	 * @param x      Logical touch x
+	 * @param y      Logical touch y
+	 * @param phase  0 on release, 1 on first contact, 2 while held
+	 */
+	void lcd_ui_keyboard_touch(lcd_ui_context_t *ctx, lcd_ui_widget_t *widget,
+				   uint16_t x, uint16_t y, uint8_t phase);
+
+	/**
+	 * @brief Draws the part of a keyboard widget that lies in ctx->clip.
+	 *        Called by lcd_ui while drawing widgets.
+	 * @param ctx        Pointer to initialized lcd_ui_context_t
+	 * @param widget     Keyboard widget
+	 * @param background Fill between the keys
+	 * @param foreground Key label colour
+	 */
+	void lcd_ui_keyboard_draw(lcd_ui_context_t *ctx,
+				  const lcd_ui_widget_t *widget,
+				  uint32_t background, uint32_t foreground);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LCD_UI_KEYBOARD_H */
@@ -0,0 +1,177 @@
+/**
+ * @file        lcd_ui_list.h
+ * @brief       Virtualised scrolling list widget.
+ *
+ * @author      Ryan Hicks <c3361231@uon.edu.au>
+ *              School of Engineering (Electrical and Computer Engineering)
+ *              University of Newcastle
+ *
+ * @date        2025-04-11
+ * @version     1.0.0
+ *
+ * @copyright   Copyright (c) 2025 Ryan
+ * @license     SPDX-License-Identifier: MIT
+ *
+ * @note        Redistribution and use permitted with attribution.
+ */
+
+#ifndef LCD_UI_LIST_H
+#define LCD_UI_LIST_H
+
+#include "lcd_ui.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+
+#ifndef LCD_UI_LIST_TEXT_SIZE
+/**
+ * @brief Bytes of text a pooled row holds, terminator included.
+ */
+#define LCD_UI_LIST_TEXT_SIZE 32U
+#endif
+
+#ifndef LCD_UI_LIST_DRAG_THRESHOLD
+/**
+ * @brief Pixels a touch must travel before it scrolls instead of taps.
+ */
+#define LCD_UI_LIST_DRAG_THRESHOLD 6U
+#endif
+
+/**
+ * @brief Row index meaning "no row".
+ */
+#define LCD_UI_LIST_NO_ROW UINT32_MAX
+
+/**
+ * @brief Pool entries a list of the given height needs so every row on
+ *        screen keeps its own entry: a partly shown row at each edge.
+ */
+#define LCD_UI_LIST_POOL_SIZE(height, row_height) ((height) / (row_height) + 2U)
+
+	/**
+	 * @brief A materialised row. Entries are recycled as rows scroll out
+	 *        of view, so only the visible rows exist at any time.
+	 */
+	typedef struct
+	{
+		uint32_t index; /* row held, LCD_UI_LIST_NO_ROW when free */
+		char text[LCD_UI_LIST_TEXT_SIZE];
+	} lcd_ui_list_row_t;
+
+	/**
+	 * @brief Data source: number of rows in the list.
+	 */
+	typedef uint32_t (*lcd_ui_list_count_t)(void *source);
+
+	/**
+	 * @brief Data source: fills in @p row for row @p index. Called only
+	 *        when the row scrolls into view or is refreshed, not per draw.
+	 */
+	typedef void (*lcd_ui_list_render_t)(void *source, uint32_t index,
+					     lcd_ui_list_row_t *row);
+
+	/**
+	 * @brief List state, referenced by a LCD_UI_WIDGET_LIST widget's data
+	 *        pointer. Rows are fixed-height and come from the data source
+	 *        on demand, so the list can be any length. The widget's
+	 *        on_touch fires when a row is tapped, with it in selected.
+	 */
+	typedef struct
+	{
+		lcd_ui_list_count_t row_count;
+		lcd_ui_list_render_t render_row;
+		void *source;
+
+		lcd_ui_list_row_t *pool; /* caller-owned, row n lives in pool[n % pool_size] */
+		uint8_t pool_size;
+		uint16_t row_height;
+
+		uint32_t scroll;   /* pixels from the top of row 0 to the top of the widget */
+		uint32_t selected; /* LCD_UI_LIST_NO_ROW for none */
+
+		/* Touch in progress */
+		uint32_t touch_scroll;
+		uint16_t touch_y;
+		uint8_t dragging;
+	} lcd_ui_list_t;
+
+	/**
+	 * @brief Prepares a list over a data source.
+	 * @param list       List to initialise
+	 * @param row_count  Row count callback
+	 * @param render_row Row render callback
+	 * @param source     Passed to both callbacks
+	 * @param pool       Row pool, see LCD_UI_LIST_POOL_SIZE()
+	 * @param pool_size  Entries in @p pool
+	 * @param row_height Row height in pixels
+	 */
+	void lcd_ui_list_init(lcd_ui_list_t *list,
+			      lcd_ui_list_count_t row_count,
+			      lcd_ui_list_render_t render_row,
+			      void *source,
+			      lcd_ui_list_row_t *pool, uint8_t pool_size,
+			      uint16_t row_height);
+
+	/**
+	 * @brief Scrolls to @p offset pixels from the top, clamped to the
+	 *        list. The content is moved with a block move and only the
+	 *        rows entering the view are drawn.
+	 * @param ctx    Pointer to initialized lcd_ui_context_t
+	 * @param widget List widget
+	 * @param offset Pixels from the top of row 0
+	 */
+	void lcd_ui_list_scroll_to(lcd_ui_context_t *ctx, lcd_ui_widget_t *widget,
+				   uint32_t offset);
+
+	/**
+	 * @brief Row under logical row @p y, or LCD_UI_LIST_NO_ROW. Worked
+	 *        out from the scroll offset; no rows are searched.
+	 */
+	uint32_t lcd_ui_list_row_at(const lcd_ui_widget_t *widget, uint16_t y);
+
+	/**
+	 * @brief Re-renders one row after its data changed, redrawing it if
+	 *        it is on screen.
+	 */
+	void lcd_ui_list_refresh_row(lcd_ui_context_t *ctx, lcd_ui_widget_t *widget,
+				     uint32_t index);
+
+	/**
+	 * @brief Drops every materialised row and redraws, for when rows were
+	 *        added, removed or reordered.
+	 */
+	void lcd_ui_list_reload(lcd_ui_context_t *ctx, lcd_ui_widget_t *widget);
+
+	/**
+	 * @brief Feeds a touch to the list: drags scroll it, taps select a
+	 *        row. Called by lcd_ui_handle_touch().
+	 * @param ctx        Pointer to initialized lcd_ui_context_t
+	 * @param widget     List widget
+	 * @param x          Logical touch x
+	 * @param y          Logical touch y
+	 * @param phase      0 on release, 1 on first contact, 2 while held
+	 */
+	void lcd_ui_list_touch(lcd_ui_context_t *ctx, lcd_ui_widget_t *widget,
+			       uint16_t x, uint16_t y, uint8_t phase);
+
+	/**
+	 * @brief Draws the rows of a list widget that lie in ctx->clip.
+	 *        Called by lcd_ui while drawing widgets.
+	 * @param ctx        Pointer to initialized lcd_ui_context_t
+	 * @param widget     List widget
+	 * @param background Row background colour
+	 * @param foreground Row text colour
+	 */
+	void lcd_ui_list_draw(lcd_ui_context_t *ctx,
+			      const lcd_ui_widget_t *widget,
+			      uint32_t background, uint32_t foreground);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LCD_UI_LIST_H */
@@ -0,0 +1,120 @@
+/**
+ * @file        lcd_ui_samples.h
+ * @brief       Descriptors for reading caller-owned sample buffers in place.
+ *
+ * @author      Ryan Hicks <c3361231@uon.edu.au>
+ *              School of Engineering (Electrical and Computer Engineering)
+ *              University of Newcastle
+ *
+ * @date        2025-04-11
+ * @version     1.0.0
+ *
+ * @copyright   Copyright (c) 2025 Ryan
+ * @license     SPDX-License-Identifier: MIT
+ *
+ * @note        Redistribution and use permitted with attribution.
+ */
+
+#ifndef LCD_UI_SAMPLES_H
+#define LCD_UI_SAMPLES_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include <string.h>
+
+	/**
+	 * @brief Storage type of one sample.
+	 */
+	typedef enum
+	{
+		LCD_UI_SAMPLE_INT32 = 0,
+		LCD_UI_SAMPLE_INT16,
+		LCD_UI_SAMPLE_UINT16, /* e.g. raw 12-bit ADC conversions */
+		LCD_UI_SAMPLE_Q15,    /* read as its raw value, so -1..1 spans -32768..32767 */
+		LCD_UI_SAMPLE_FLOAT,  /* multiplied by gain and truncated */
+	} lcd_ui_sample_type_t;
+
+	/**
+	 * @brief A caller-owned array of samples, read where it lies. Lets a
+	 *        chart or pyramid plot a DMA or ADC buffer without copying it
+	 *        into int32_t storage first.
+	 */
+	typedef struct
+	{
+		const void *base;
+		float gain;      /* LCD_UI_SAMPLE_FLOAT only: value to chart units */
+		uint16_t stride; /* bytes from one sample to the next */
+		uint8_t type;    /* lcd_ui_sample_type_t */
+	} lcd_ui_samples_t;
+
+/**
+ * @brief Bytes in one sample of @p type.
+ */
+#define LCD_UI_SAMPLE_SIZE(type) \
+	(((type) == LCD_UI_SAMPLE_INT16 || (type) == LCD_UI_SAMPLE_UINT16 || (type) == LCD_UI_SAMPLE_Q15) ? 2U : 4U)
+
+/**
+ * @brief Descriptor for a packed array of @p type.
+ */
+#define LCD_UI_SAMPLES(base, type) \
+	{(base), 1.0f, (uint16_t)LCD_UI_SAMPLE_SIZE(type), (uint8_t)(type)}
+
+/**
+ * @brief Descriptor for one field of an array of structs or one channel
+ *        of an interleaved multi-channel buffer, @p stride bytes apart.
+ */
+#define LCD_UI_SAMPLES_STRIDED(base, type, stride) \
+	{(base), 1.0f, (uint16_t)(stride), (uint8_t)(type)}
+
+	/**
+	 * @brief Reads sample @p index as chart units. Unaligned buffers
+	 *        are fine.
+	 */
+	static inline int32_t lcd_ui_sample_read(const lcd_ui_samples_t *samples, uint32_t index)
+	{
+		const uint8_t *at = (const uint8_t *)samples->base + (size_t)index * samples->stride;
+
+		switch (samples->type)
+		{
+		case LCD_UI_SAMPLE_INT16:
+		case LCD_UI_SAMPLE_Q15:
+		{
+			int16_t value;
+			memcpy(&value, at, sizeof(value));
+			return value;
+		}
+		case LCD_UI_SAMPLE_UINT16:
+		{
+			uint16_t value;
+			memcpy(&value, at, sizeof(value));
+			return value;
+		}
+		case LCD_UI_SAMPLE_FLOAT:
+		{
+			float value;
+			memcpy(&value, at, sizeof(value));
+			value *= samples->gain;
+			if (value >= 2147483647.0f)
+				return INT32_MAX;
+			if (value <= -2147483648.0f)
+				return INT32_MIN;
+			return (value == value) ? (int32_t)value : 0; /* NaN plots as 0 */
+		}
+		default:
+		{
+			int32_t value;
+			memcpy(&value, at, sizeof(value));
+			return value;
+		}
+		}
+	}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LCD_UI_SAMPLES_H */
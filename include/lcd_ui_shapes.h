@@ -0,0 +1,152 @@
+/**
+ * @file        lcd_ui_shapes.h
+ * @brief       Lines, circles, arcs and rounded rectangles as span batches.
+ *
+ * @author      Ryan Hicks <c3361231@uon.edu.au>
+ *              School of Engineering (Electrical and Computer Engineering)
+ *              University of Newcastle
+ *
+ * @date        2025-04-11
+ * @version     1.0.0
+ *
+ * @copyright   Copyright (c) 2025 Ryan
+ * @license     SPDX-License-Identifier: MIT
+ *
+ * @note        Redistribution and use permitted with attribution.
+ */
+
+#ifndef LCD_UI_SHAPES_H
+#define LCD_UI_SHAPES_H
+
+#include "lcd_ui.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+
+/**
+ * @brief Largest corner radius whose outline is kept in a table rather
+ *        than worked out per row.
+ */
+#define LCD_UI_CORNER_TABLE_RADIUS 16U
+
+/**
+ * @brief Units per pixel of anti-aliased line coordinates, so end points
+ *        can move by less than a pixel. Multiples fall on pixel centres.
+ */
+#define LCD_UI_SUBPIXEL 16
+
+	/*
+	 * Every shape is broken into horizontal spans and filled through
+	 * lcd_ui_fill_spans(), a batch at a time. Coordinates are logical
+	 * and may lie partly off screen; everything is clipped to ctx->clip.
+	 * A circle of radius r covers 2r + 1 pixels across. Angles are in
+	 * degrees, clockwise from 12 o'clock.
+	 */
+
+	/**
+	 * @brief Draws a straight line. Bresenham steps along the longer
+	 *        axis and pixels sharing a row are merged into one span.
+	 * @param ctx    Pointer to initialized lcd_ui_context_t
+	 * @param x0     Start x
+	 * @param y0     Start y
+	 * @param x1     End x
+	 * @param y1     End y
+	 * @param width  Pen width in pixels, across the longer axis
+	 * @param colour Line colour
+	 */
+	void lcd_ui_draw_line(lcd_ui_context_t *ctx,
+			      int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+			      uint8_t width, uint32_t colour);
+
+	/**
+	 * @brief Fills a circle, one span per row.
+	 */
+	void lcd_ui_fill_circle(lcd_ui_context_t *ctx,
+				int16_t cx, int16_t cy, uint16_t radius,
+				uint32_t colour);
+
+	/**
+	 * @brief Draws a circle outline @p thickness pixels wide, inside
+	 *        @p radius. At most two spans per row.
+	 */
+	void lcd_ui_draw_circle(lcd_ui_context_t *ctx,
+				int16_t cx, int16_t cy, uint16_t radius,
+				uint16_t thickness, uint32_t colour);
+
+	/**
+	 * @brief Draws part of a circle outline. The ends are cut along the
+	 *        radii at the start and end angles; a thickness above the
+	 *        radius gives a pie slice.
+	 * @param ctx         Pointer to initialized lcd_ui_context_t
+	 * @param cx          Centre x
+	 * @param cy          Centre y
+	 * @param radius      Outer radius
+	 * @param thickness   Band width inside @p radius
+	 * @param start_angle Where the arc begins
+	 * @param sweep       Degrees covered clockwise, negative for
+	 *                    anticlockwise; 360 or more is a full circle
+	 * @param colour      Arc colour
+	 */
+	void lcd_ui_draw_arc(lcd_ui_context_t *ctx,
+			     int16_t cx, int16_t cy, uint16_t radius,
+			     uint16_t thickness,
+			     int16_t start_angle, int16_t sweep,
+			     uint32_t colour);
+
+	/**
+	 * @brief Fills a rectangle with rounded corners. Corner outlines up
+	 *        to LCD_UI_CORNER_TABLE_RADIUS come from a constant table.
+	 *        The radius is limited to fit the rectangle.
+	 */
+	void lcd_ui_fill_round_rect(lcd_ui_context_t *ctx,
+				    int16_t x, int16_t y, uint16_t w, uint16_t h,
+				    uint16_t radius, uint32_t colour);
+
+	/**
+	 * @brief Draws the outline of a rounded rectangle, @p thickness
+	 *        pixels wide, inside the given bounds.
+	 */
+	void lcd_ui_draw_round_rect(lcd_ui_context_t *ctx,
+				    int16_t x, int16_t y, uint16_t w, uint16_t h,
+				    uint16_t radius, uint16_t thickness,
+				    uint32_t colour);
+
+	/*
+	 * The anti-aliased versions fill the pixels a shape covers
+	 * completely as spans, as above, and blend only those on its edges,
+	 * by coverage, through lcd_ui_blend_spans().
+	 */
+
+	/**
+	 * @brief Draws an anti-aliased line with square-cut ends.
+	 * @param ctx    Pointer to initialized lcd_ui_context_t
+	 * @param x0     Start x, in LCD_UI_SUBPIXEL units
+	 * @param y0     Start y, in LCD_UI_SUBPIXEL units
+	 * @param x1     End x, in LCD_UI_SUBPIXEL units
+	 * @param y1     End y, in LCD_UI_SUBPIXEL units
+	 * @param width  Pen width across the line, in LCD_UI_SUBPIXEL units
+	 * @param colour Line colour
+	 */
+	void lcd_ui_draw_line_aa(lcd_ui_context_t *ctx,
+				 int32_t x0, int32_t y0, int32_t x1, int32_t y1,
+				 uint16_t width, uint32_t colour);
+
+	/**
+	 * @brief lcd_ui_draw_arc() with smooth edges and cut ends. A sweep of
+	 *        360 or more with a thickness above the radius gives a disc.
+	 */
+	void lcd_ui_draw_arc_aa(lcd_ui_context_t *ctx,
+				int16_t cx, int16_t cy, uint16_t radius,
+				uint16_t thickness,
+				int16_t start_angle, int16_t sweep,
+				uint32_t colour);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LCD_UI_SHAPES_H */
@@ -0,0 +1,152 @@
+/**
+ * @file        lcd_ui_surface.h
+ * @brief       Offscreen surfaces caching the static layer of widgets.
+ *
+ * @author      Ryan Hicks <c3361231@uon.edu.au>
+ *              School of Engineering (Electrical and Computer Engineering)
+ *              University of Newcastle
+ *
+ * @date        2025-04-11
+ * @version     1.0.0
+ *
+ * @copyright   Copyright (c) 2025 Ryan
+ * @license     SPDX-License-Identifier: MIT
+ *
+ * @note        Redistribution and use permitted with attribution.
+ */
+
+#ifndef LCD_UI_SURFACE_H
+#define LCD_UI_SURFACE_H
+
+#include "lcd_ui.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+	typedef struct lcd_ui_surface_cache lcd_ui_surface_cache_t;
+
+	/**
+	 * @brief Draws the static layer of @p widget through @p ctx, using
+	 *        only the public drawing calls (lcd_ui_fill_rect(),
+	 *        lcd_ui_draw_text(), ...) and the widget's x and y as its
+	 *        origin. Called with an offscreen context when the layer is
+	 *        cached, or with the screen context when it does not fit.
+	 */
+	typedef void (*lcd_ui_surface_render_t)(lcd_ui_context_t *ctx,
+						const lcd_ui_widget_t *widget,
+						void *user_data);
+
+	/**
+	 * @brief One widget's cached layer. Owned by the caller; the pixels
+	 *        live in the cache's arena and may be evicted at any time.
+	 */
+	typedef struct lcd_ui_surface
+	{
+		lcd_ui_surface_cache_t *cache;
+		lcd_ui_surface_render_t render;
+		void *user_data;
+
+		uint32_t *pixels; /* ARGB8888, NULL while not cached */
+
+		/* What the pixels were rendered for; any change re-renders */
+		uint16_t width;
+		uint16_t height;
+		uint32_t background;
+		uint32_t foreground;
+		uint32_t theme_version;
+
+		uint32_t last_used;
+		struct lcd_ui_surface *next;
+	} lcd_ui_surface_t;
+
+	/**
+	 * @brief Memory shared by a set of surfaces. The arena is the budget:
+	 *        when a layer does not fit, the least recently drawn layers
+	 *        are evicted and the rest moved down to close the gaps.
+	 */
+	struct lcd_ui_surface_cache
+	{
+		uint32_t *arena;
+		size_t capacity; /* pixels */
+		size_t used;     /* pixels up to the end of the last layer */
+		uint32_t clock;
+		lcd_ui_surface_t *surfaces;
+
+		/* Counters for tuning the budget */
+		uint32_t renders;
+		uint32_t evictions;
+	};
+
+	/**
+	 * @brief Prepares a cache over a caller-owned buffer.
+	 * @param cache  Cache to initialise
+	 * @param buffer Pixel storage, 4-byte aligned
+	 * @param size   Size of @p buffer in bytes
+	 */
+	void lcd_ui_surface_cache_init(lcd_ui_surface_cache_t *cache,
+				       void *buffer, size_t size);
+
+	/**
+	 * @brief Registers a surface with a cache. Nothing is rendered until
+	 *        it is first drawn. A surface already registered with
+	 *        @p cache is reset and keeps a single entry.
+	 * @param cache     Cache to take pixels from
+	 * @param surface   Surface to initialise
+	 * @param render    Draws the static layer
+	 * @param user_data Passed to @p render
+	 */
+	void lcd_ui_surface_init(lcd_ui_surface_cache_t *cache,
+				 lcd_ui_surface_t *surface,
+				 lcd_ui_surface_render_t render,
+				 void *user_data);
+
+	/**
+	 * @brief Removes a surface from its cache, freeing its pixels.
+	 */
+	void lcd_ui_surface_remove(lcd_ui_surface_t *surface);
+
+	/**
+	 * @brief Discards a surface's pixels so the next draw re-renders
+	 *        them. Needed only when the layer's content changes; size,
+	 *        colour and theme changes are picked up by themselves.
+	 */
+	void lcd_ui_surface_invalidate(lcd_ui_surface_t *surface);
+
+	/**
+	 * @brief Draws the static layer of @p widget, clipped to ctx->clip,
+	 *        as one blit from the cache. The layer is rendered first if it
+	 *        is missing or out of date. A layer larger than the whole
+	 *        arena is rendered straight to the screen instead.
+	 *        Draw the dynamic parts on top afterwards.
+	 * @param ctx     Pointer to initialized lcd_ui_context_t
+	 * @param surface The widget's surface
+	 * @param widget  Widget being drawn
+	 * @return 0 if the layer was rendered straight to the screen
+	 */
+	uint8_t lcd_ui_surface_draw(lcd_ui_context_t *ctx,
+				    lcd_ui_surface_t *surface,
+				    const lcd_ui_widget_t *widget);
+
+	/**
+	 * @brief Renders the whole page, every widget of @p ctx over its
+	 *        background colour, into an ARGB8888 buffer instead of onto
+	 *        the display. The buffer holds the logical screen unrotated,
+	 *        screen_width pixels to a row. Widgets with state, such as a
+	 *        gauge's needle, end up as if drawn on screen.
+	 * @param ctx    Pointer to initialized lcd_ui_context_t
+	 * @param pixels Caller-owned buffer, 4-byte aligned
+	 * @param size   Size of @p pixels in bytes
+	 * @return 0 if the buffer is too small
+	 */
+	uint8_t lcd_ui_render_offscreen(lcd_ui_context_t *ctx, uint32_t *pixels, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LCD_UI_SURFACE_H */
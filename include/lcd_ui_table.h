@@ -0,0 +1,148 @@
+/**
+ * @file        lcd_ui_table.h
+ * @brief       Grid of live values with per-cell dirty tracking.
+ *
+ * @author      Ryan Hicks <c3361231@uon.edu.au>
+ *              School of Engineering (Electrical and Computer Engineering)
+ *              University of Newcastle
+ *
+ * @date        2025-04-11
+ * @version     1.0.0
+ *
+ * @copyright   Copyright (c) 2025 Ryan
+ * @license     SPDX-License-Identifier: MIT
+ *
+ * @note        Redistribution and use permitted with attribution.
+ */
+
+#ifndef LCD_UI_TABLE_H
+#define LCD_UI_TABLE_H
+
+#include "lcd_ui.h"
+#include "lcd_ui_samples.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef LCD_UI_TABLE_TEXT_SIZE
+/**
+ * @brief Bytes of text one cell can show, terminator included.
+ */
+#define LCD_UI_TABLE_TEXT_SIZE 16U
+#endif
+
+/**
+ * @brief Words of dirty bitset a table of rows x columns needs.
+ */
+#define LCD_UI_TABLE_DIRTY_WORDS(rows, columns) (((uint32_t)(rows) * (columns) + 31U) / 32U)
+
+	/**
+	 * @brief Writes the text of one cell into @p text (@p size bytes).
+	 *        Overrides the value buffer when set.
+	 */
+	typedef void (*lcd_ui_table_format_t)(void *source, uint16_t row, uint16_t column,
+					      char *text, size_t size);
+
+	/**
+	 * @brief Table state, referenced by a LCD_UI_WIDGET_TABLE widget's data
+	 *        pointer. The widget is split into equal cells, row-major.
+	 *        Cell text comes from format_cell, or else from values,
+	 *        printed as fixed point with the given decimals. Cells are
+	 *        aligned by the widget's text_align. on_touch fires on a
+	 *        press, with the cell in touched_row and touched_column.
+	 */
+	typedef struct
+	{
+		uint16_t rows;
+		uint16_t columns;
+
+		lcd_ui_samples_t values; /* cell (r, c) is sample r * columns + c */
+		uint8_t decimals; /* 0..10 */
+		lcd_ui_table_format_t format_cell;
+		void *source;
+
+		uint32_t *dirty; /* caller-owned, LCD_UI_TABLE_DIRTY_WORDS() words */
+
+		/* Geometry, recomputed when the widget is resized */
+		uint16_t layout_width;
+		uint16_t layout_height;
+		uint16_t cell_width;
+		uint16_t cell_height;
+
+		uint16_t touched_row;
+		uint16_t touched_column;
+	} lcd_ui_table_t;
+
+	/**
+	 * @brief Prepares a table. Set values or format_cell afterwards.
+	 * @param table   Table to initialise
+	 * @param rows    Number of rows
+	 * @param columns Number of columns
+	 * @param dirty   Dirty bitset storage, LCD_UI_TABLE_DIRTY_WORDS() words
+	 */
+	void lcd_ui_table_init(lcd_ui_table_t *table,
+			       uint16_t rows, uint16_t columns,
+			       uint32_t *dirty);
+
+	/**
+	 * @brief Flags one cell for repaint at the next lcd_ui_table_update().
+	 *        Only sets a bit, so it is cheap to call wherever the value
+	 *        is written.
+	 */
+	void lcd_ui_table_mark(lcd_ui_table_t *table, uint16_t row, uint16_t column);
+
+	/**
+	 * @brief Flags every cell for repaint.
+	 */
+	void lcd_ui_table_mark_all(lcd_ui_table_t *table);
+
+	/**
+	 * @brief Repaints the flagged cells and clears their flags. Clean
+	 *        words of the bitset are skipped 32 cells at a time.
+	 * @param ctx    Pointer to initialized lcd_ui_context_t
+	 * @param widget Table widget
+	 */
+	void lcd_ui_table_update(lcd_ui_context_t *ctx, lcd_ui_widget_t *widget);
+
+	/**
+	 * @brief Finds the cell under a logical point by division.
+	 * @param widget Table widget
+	 * @param x      Logical x
+	 * @param y      Logical y
+	 * @param row    Receives the row
+	 * @param column Receives the column
+	 * @return 0 if the point is outside the cells
+	 */
+	uint8_t lcd_ui_table_cell_at(const lcd_ui_widget_t *widget,
+				     uint16_t x, uint16_t y,
+				     uint16_t *row, uint16_t *column);
+
+	/**
+	 * @brief Records the cell under a press and fires on_touch. Called
+	 *        by lcd_ui_handle_touch().
+	 */
+	void lcd_ui_table_touch(lcd_ui_context_t *ctx, lcd_ui_widget_t *widget,
+				uint16_t x, uint16_t y);
+
+	/**
+	 * @brief Draws the cells of a table widget that lie in ctx->clip.
+	 *        Called by lcd_ui while drawing widgets.
+	 * @param ctx        Pointer to initialized lcd_ui_context_t
+	 * @param widget     Table widget
+	 * @param background Cell background colour
+	 * @param foreground Cell text colour
+	 */
+	void lcd_ui_table_draw(lcd_ui_context_t *ctx,
+			       const lcd_ui_widget_t *widget,
+			       uint32_t background, uint32_t foreground);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LCD_UI_TABLE_H */
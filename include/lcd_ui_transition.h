@@ -0,0 +1,129 @@
+/**
+ * @file        lcd_ui_transition.h
+ * @brief       Slide and push page transitions done with block moves.
+ *
+ * @author      Ryan Hicks <c3361231@uon.edu.au>
+ *              School of Engineering (Electrical and Computer Engineering)
+ *              University of Newcastle
+ *
+ * @date        2025-04-11
+ * @version     1.0.0
+ *
+ * @copyright   Copyright (c) 2025 Ryan
+ * @license     SPDX-License-Identifier: MIT
+ *
+ * @note        Redistribution and use permitted with attribution.
+ */
+
+#ifndef LCD_UI_TRANSITION_H
+#define LCD_UI_TRANSITION_H
+
+#include "lcd_ui.h"
+#include "lcd_ui_anim.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+	/**
+	 * @brief How the pages move.
+	 */
+	typedef enum
+	{
+		LCD_UI_TRANSITION_SLIDE = 0, /* the new page slides over the old one */
+		LCD_UI_TRANSITION_PUSH,      /* the new page pushes the old one off */
+	} lcd_ui_transition_style_t;
+
+	/**
+	 * @brief Screen edge the new page comes in from.
+	 */
+	typedef enum
+	{
+		LCD_UI_FROM_RIGHT = 0,
+		LCD_UI_FROM_LEFT,
+		LCD_UI_FROM_BOTTOM,
+		LCD_UI_FROM_TOP,
+	} lcd_ui_edge_t;
+
+	/**
+	 * @brief A page change in progress. The page buffers are owned by
+	 *        the caller and must stay valid until it finishes.
+	 */
+	typedef struct
+	{
+		lcd_ui_context_t *ctx;
+		const uint32_t *incoming; /* the new page, rendered once */
+		const uint32_t *outgoing; /* the old page, or NULL to move it on screen */
+
+		uint32_t start_us;
+		uint32_t duration_us;
+
+		uint16_t distance; /* screen width or height, along the move */
+		uint16_t offset;   /* how far the new page has come in */
+
+		uint8_t style;   /* lcd_ui_transition_style_t */
+		uint8_t edge;    /* lcd_ui_edge_t */
+		uint8_t easing;  /* lcd_ui_easing_t */
+		uint8_t started; /* start_us set by the first step */
+		uint8_t running;
+
+		uint32_t frames;
+	} lcd_ui_transition_t;
+
+	/**
+	 * @brief Starts changing to the page now in @p ctx's widget list.
+	 *        The old page is still on screen: replace the widgets with
+	 *        lcd_ui_clear_widgets() and lcd_ui_add_widget(), not
+	 *        lcd_ui_reset_screen(), then call this. The new page is
+	 *        rendered once, into @p page_buffer; nothing is drawn on
+	 *        screen until the first step.
+	 *
+	 *        Each step moves what is already on screen with
+	 *        lcd_ui_move_pixels() and copies in only the strip of the new
+	 *        page uncovered since the last step. If the driver cannot
+	 *        move pixels, the visible part of each page is copied from
+	 *        its buffer instead; a push then needs @p outgoing, or the
+	 *        old page stays put and the new one slides over it.
+	 *
+	 * @param trans       Transition to start
+	 * @param ctx         Pointer to initialized lcd_ui_context_t
+	 * @param page_buffer Caller-owned buffer of screen_width * screen_height
+	 *                    ARGB8888 pixels for the new page
+	 * @param size        Size of @p page_buffer in bytes
+	 * @param outgoing    The old page, rendered with lcd_ui_render_offscreen()
+	 *                    before its widgets were removed, or NULL
+	 * @param background  Background of the new page, as given to
+	 *                    lcd_ui_reset_screen()
+	 * @param style       Slide or push
+	 * @param edge        Edge the new page comes in from
+	 * @param duration_us Length of the transition
+	 * @param easing      Easing curve
+	 * @return 0 if the buffer is too small; the new page is then drawn
+	 *         at once, without a transition
+	 */
+	uint8_t lcd_ui_transition_start(lcd_ui_transition_t *trans, lcd_ui_context_t *ctx,
+					uint32_t *page_buffer, size_t size,
+					const uint32_t *outgoing, uint32_t background,
+					lcd_ui_transition_style_t style, lcd_ui_edge_t edge,
+					uint32_t duration_us, lcd_ui_easing_t easing);
+
+	/**
+	 * @brief Draws the transition as it stands at @p now_us. Call every
+	 *        frame; the first call sets the start time. Touch input
+	 *        should wait until it returns 0, when the new page is fully
+	 *        on screen.
+	 * @param trans  Transition
+	 * @param now_us Free-running microsecond clock; it may wrap
+	 * @return Non-zero while the transition is still running
+	 */
+	uint8_t lcd_ui_transition_step(lcd_ui_transition_t *trans, uint32_t now_us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LCD_UI_TRANSITION_H */
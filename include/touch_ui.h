@@ -28,6 +28,8 @@ extern "C"
 
 	/**
 	 * @brief Board- or hardware-specific driver interface for one-finger touch input.
+	 *        Every callback receives the opaque instance pointer given to
+	 *        touch_ui_init(), so one driver can serve several controllers.
 	 */
 	typedef struct touch_ui_driver_t
 	{
@@ -35,7 +37,7 @@ extern "C"
 		 * @brief Initializes the underlying touchscreen hardware.
 		 *        Possibly sets up pins, I2C, EXTI or timers.
 		 */
-		void (*initialize)(void);
+		void (*initialize)(void *instance);
 
 		/**
 		 * @brief Reads the current state of the touchscreen.
@@ -45,7 +47,8 @@ extern "C"
 		 * @param timestamp_value Output: Current time in ms or ticks
 		 * @return                True if read succeeded, false if error/no data
 		 */
-		bool (*read_touch_state)(uint16_t *x_position,
+		bool (*read_touch_state)(void *instance,
+					 uint16_t *x_position,
 					 uint16_t *y_position,
 					 bool *is_pressed,
 					 uint32_t *timestamp_value);
@@ -54,7 +57,7 @@ extern "C"
 		 * @brief Optionally enables or disables an interrupt or other callback mechanism.
 		 *        If the user wants polling only, this can be a no-op.
 		 */
-		void (*enable_interrupt)(bool enable_flag);
+		void (*enable_interrupt)(void *instance, bool enable_flag);
 
 	} touch_ui_driver_t;
 
@@ -122,6 +125,9 @@ extern "C"
 
 		const touch_ui_driver_t *driver;
 
+		/** @brief Opaque pointer passed to every driver callback. */
+		void *driver_instance;
+
 		/** @brief Future expansions: multi-touch state, gesture buffers, etc. */
 	} touch_ui_context_t;
 
@@ -129,8 +135,11 @@ extern "C"
 	 * @brief Initializes the touch UI context.
 	 * @param context Pointer to an allocated touch_ui_context_t structure.
 	 * @param driver  Pointer to a driver structure.
+	 * @param driver_instance Opaque pointer handed to the driver callbacks.
 	 */
-	void touch_ui_init(touch_ui_context_t *context, const touch_ui_driver_t *driver);
+	void touch_ui_init(touch_ui_context_t *context,
+			   const touch_ui_driver_t *driver,
+			   void *driver_instance);
 
 	/**
 	 * @brief Processes raw touch input (x, y, pressed) to produce a higher-level event.
@@ -28,12 +28,32 @@ extern "C"
 #include <stdint.h>
 #include <stdbool.h>
 
+	/**
+	 * @brief Per-controller state handed to every BSP driver callback.
+	 */
+	typedef struct touch_ui_bsp_instance_t
+	{
+		/** @brief BSP_TS instance number. */
+		uint32_t ts_instance;
+
+		/** @brief Last reported X, held while no finger is down. */
+		uint16_t last_x_position;
+
+		/** @brief Last reported Y, held while no finger is down. */
+		uint16_t last_y_position;
+	} touch_ui_bsp_instance_t;
+
 	/**
 	 * @brief Extern a board-specific driver instance, e.g.:
 	 *        extern const touch_ui_driver_t my_board_touch_driver;
 	 */
 	extern const touch_ui_driver_t touch_ui_bsp_driver;
 
+	/**
+	 * @brief Default instance for the on-board touch controller.
+	 */
+	extern touch_ui_bsp_instance_t touch_ui_bsp_instance;
+
 #ifdef __cplusplus
 }
 #endif
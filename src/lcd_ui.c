@@ -16,216 +16,2241 @@
  */
 
 #include "lcd_ui.h"
+#include "lcd_ui_chart.h"
+#include "lcd_ui_gauge.h"
+#include "lcd_ui_image.h"
+#include "lcd_ui_keyboard.h"
+#include "lcd_ui_list.h"
+#include "lcd_ui_table.h"
 #include "lcd_ui_colours.h"
+#include "lcd_ui_gamma.h"
 #include <string.h>
 
+static uint8_t rect_is_empty(const lcd_ui_rect_t *rect)
+{
+	return (rect->width == 0U) || (rect->height == 0U);
+}
+
+static uint8_t rect_intersects(const lcd_ui_rect_t *a, const lcd_ui_rect_t *b)
+{
+	return (a->x < b->x + b->width) && (b->x < a->x + a->width) &&
+	       (a->y < b->y + b->height) && (b->y < a->y + a->height);
+}
+
+static uint8_t rect_contains(const lcd_ui_rect_t *outer, const lcd_ui_rect_t *inner)
+{
+	return (inner->x >= outer->x) && (inner->y >= outer->y) &&
+	       (inner->x + inner->width <= outer->x + outer->width) &&
+	       (inner->y + inner->height <= outer->y + outer->height);
+}
+
+static lcd_ui_rect_t rect_union(const lcd_ui_rect_t *a, const lcd_ui_rect_t *b)
+{
+	lcd_ui_rect_t result;
+	uint16_t x1 = (a->x + a->width > b->x + b->width) ? (a->x + a->width) : (b->x + b->width);
+	uint16_t y1 = (a->y + a->height > b->y + b->height) ? (a->y + a->height) : (b->y + b->height);
+
+	result.x = (a->x < b->x) ? a->x : b->x;
+	result.y = (a->y < b->y) ? a->y : b->y;
+	result.width = x1 - result.x;
+	result.height = y1 - result.y;
+	return result;
+}
+
+static uint8_t rect_intersection(const lcd_ui_rect_t *a, const lcd_ui_rect_t *b,
+				 lcd_ui_rect_t *result)
+{
+	uint16_t x0 = (a->x > b->x) ? a->x : b->x;
+	uint16_t y0 = (a->y > b->y) ? a->y : b->y;
+	uint16_t x1 = (a->x + a->width < b->x + b->width) ? (a->x + a->width) : (b->x + b->width);
+	uint16_t y1 = (a->y + a->height < b->y + b->height) ? (a->y + a->height) : (b->y + b->height);
+
+	if ((x1 <= x0) || (y1 <= y0))
+		return 0U;
+
+	result->x = x0;
+	result->y = y0;
+	result->width = x1 - x0;
+	result->height = y1 - y0;
+	return 1U;
+}
+
+static uint32_t rect_area(const lcd_ui_rect_t *rect)
+{
+	return (uint32_t)rect->width * rect->height;
+}
+
+/**
+ * @brief Clamps a rectangle to the screen. Returns 0 if nothing is left.
+ */
+static uint8_t rect_clip_to_screen(const lcd_ui_context_t *ctx, lcd_ui_rect_t *rect)
+{
+	if ((rect->x >= ctx->screen_width) || (rect->y >= ctx->screen_height))
+		return 0U;
+
+	if (rect->x + rect->width > ctx->screen_width)
+		rect->width = ctx->screen_width - rect->x;
+	if (rect->y + rect->height > ctx->screen_height)
+		rect->height = ctx->screen_height - rect->y;
+
+	return !rect_is_empty(rect);
+}
+
+/**
+ * @brief Moves a rectangle by (dx, dy), cutting off anything pushed past
+ *        the top or left edge. Returns 0 if nothing is left.
+ */
+static uint8_t rect_offset(const lcd_ui_rect_t *rect, int16_t dx, int16_t dy,
+			   lcd_ui_rect_t *result)
+{
+	int32_t x0 = (int32_t)rect->x + dx;
+	int32_t y0 = (int32_t)rect->y + dy;
+	const int32_t x1 = x0 + rect->width;
+	const int32_t y1 = y0 + rect->height;
+
+	if (x0 < 0)
+		x0 = 0;
+	if (y0 < 0)
+		y0 = 0;
+	if ((x1 <= x0) || (y1 <= y0))
+		return 0U;
+
+	result->x = (uint16_t)x0;
+	result->y = (uint16_t)y0;
+	result->width = (uint16_t)(x1 - x0);
+	result->height = (uint16_t)(y1 - y0);
+	return 1U;
+}
+
+/**
+ * @brief Maps a logical rectangle onto the panel for the current rotation.
+ */
+static lcd_ui_rect_t rect_to_native(const lcd_ui_context_t *ctx,
+				    const lcd_ui_rect_t *rect)
+{
+	lcd_ui_rect_t native = *rect;
+
+	switch (ctx->rotation)
+	{
+	case LCD_UI_ROTATION_90:
+		native.x = ctx->native_width - rect->y - rect->height;
+		native.y = rect->x;
+		native.width = rect->height;
+		native.height = rect->width;
+		break;
+	case LCD_UI_ROTATION_180:
+		native.x = ctx->native_width - rect->x - rect->width;
+		native.y = ctx->native_height - rect->y - rect->height;
+		break;
+	case LCD_UI_ROTATION_270:
+		native.x = rect->y;
+		native.y = ctx->native_height - rect->x - rect->width;
+		native.width = rect->height;
+		native.height = rect->width;
+		break;
+	case LCD_UI_ROTATION_0:
+	default:
+		break;
+	}
+
+	return native;
+}
+
+/**
+ * @brief Maps a panel point (e.g. a touch) into logical coordinates.
+ */
+static void point_from_native(const lcd_ui_context_t *ctx,
+			      uint16_t *x, uint16_t *y)
+{
+	const uint16_t nx = *x;
+	const uint16_t ny = *y;
+
+	if ((nx >= ctx->native_width) || (ny >= ctx->native_height))
+		return;
+
+	switch (ctx->rotation)
+	{
+	case LCD_UI_ROTATION_90:
+		*x = ny;
+		*y = ctx->native_width - 1U - nx;
+		break;
+	case LCD_UI_ROTATION_180:
+		*x = ctx->native_width - 1U - nx;
+		*y = ctx->native_height - 1U - ny;
+		break;
+	case LCD_UI_ROTATION_270:
+		*x = ctx->native_height - 1U - ny;
+		*y = nx;
+		break;
+	case LCD_UI_ROTATION_0:
+	default:
+		break;
+	}
+}
+
+/**
+ * @brief Adds a rectangle to a bounded rect list, merging it with every
+ *        entry it overlaps. When the list is full the new rect is folded
+ *        into whichever entry grows the least.
+ */
+static void rect_list_add(lcd_ui_rect_t *list, uint8_t *count,
+			  const lcd_ui_rect_t *rect)
+{
+	lcd_ui_rect_t merged = *rect;
+	uint8_t i = 0U;
+
+	if (rect_is_empty(rect))
+		return;
+
+	while (i < *count)
+	{
+		if (rect_intersects(&list[i], &merged))
+		{
+			merged = rect_union(&list[i], &merged);
+			list[i] = list[--(*count)];
+			i = 0U; /* merged grew, rescan */
+		}
+		else
+		{
+			++i;
+		}
+	}
+
+	if (*count < LCD_UI_MAX_DAMAGE_RECTS)
+	{
+		list[(*count)++] = merged;
+		return;
+	}
+
+	uint8_t best = 0U;
+	uint32_t best_growth = UINT32_MAX;
+
+	for (i = 0U; i < *count; ++i)
+	{
+		lcd_ui_rect_t candidate = rect_union(&list[i], &merged);
+		uint32_t growth = rect_area(&candidate) - rect_area(&list[i]);
+
+		if (growth < best_growth)
+		{
+			best_growth = growth;
+			best = i;
+		}
+	}
+
+	list[best] = rect_union(&list[best], &merged);
+}
+
+/**
+ * @brief Copies every remaining stale region forward into the back buffer.
+ */
+static void flush_stale(lcd_ui_context_t *ctx)
+{
+	if (ctx->driver->sync_rect)
+	{
+		for (uint8_t i = 0U; i < ctx->stale_count; ++i)
+		{
+			ctx->driver->sync_rect(ctx->driver_instance,
+					       ctx->stale[i].x,
+					       ctx->stale[i].y,
+					       ctx->stale[i].width,
+					       ctx->stale[i].height);
+		}
+	}
+
+	ctx->stale_count = 0U;
+}
+
+/**
+ * @brief Brings stale back buffer regions under a panel area up to date,
+ *        or drops them when an opaque draw will cover them anyway.
+ */
+static void sync_stale_under(lcd_ui_context_t *ctx,
+			     const lcd_ui_rect_t *native,
+			     uint8_t opaque)
+{
+	uint8_t i = 0U;
+
+	while (i < ctx->stale_count)
+	{
+		const lcd_ui_rect_t *stale = &ctx->stale[i];
+
+		if (opaque && rect_contains(native, stale))
+		{
+			ctx->stale[i] = ctx->stale[--ctx->stale_count];
+		}
+		else if (rect_intersects(native, stale))
+		{
+			if (ctx->driver->sync_rect)
+			{
+				ctx->driver->sync_rect(ctx->driver_instance,
+						       stale->x, stale->y,
+						       stale->width, stale->height);
+			}
+			ctx->stale[i] = ctx->stale[--ctx->stale_count];
+		}
+		else
+		{
+			++i;
+		}
+	}
+}
+
+/**
+ * @brief Position of a widget in the draw order, or -1 for widgets drawn
+ *        from outside the list, which are treated as beneath everything.
+ */
+static int16_t widget_z(const lcd_ui_context_t *ctx, const lcd_ui_widget_t *widget)
+{
+	for (uint8_t i = 0U; i < ctx->widget_count; ++i)
+	{
+		if (ctx->widgets[i] == widget)
+			return (int16_t)i;
+	}
+
+	return -1;
+}
+
+/**
+ * @brief Must be called before drawing into logical @p area. Syncs stale
+ *        back buffer regions, invalidates the save-under of any overlay
+ *        being drawn beneath, and records the damage.
+ */
+static void begin_draw(lcd_ui_context_t *ctx,
+		       const lcd_ui_rect_t *area,
+		       uint8_t opaque)
+{
+	lcd_ui_rect_t clipped;
+
+	if (!rect_intersection(area, &ctx->clip, &clipped))
+		return;
+
+	for (lcd_ui_overlay_t *overlay = ctx->overlays; overlay; overlay = overlay->next)
+	{
+		if (overlay->saved &&
+		    (overlay->widget != ctx->drawing_widget) &&
+		    rect_intersects(&clipped, &overlay->area) &&
+		    (widget_z(ctx, ctx->drawing_widget) < widget_z(ctx, overlay->widget)))
+		{
+			overlay->saved = 0U;
+		}
+	}
+
+	/* Buffer bookkeeping is in panel coordinates */
+	clipped = rect_to_native(ctx, &clipped);
+
+	sync_stale_under(ctx, &clipped, opaque);
+	rect_list_add(ctx->damage, &ctx->damage_count, &clipped);
+}
+
+/**
+ * @brief Fills a rectangle through the driver, clipped to ctx->clip.
+ */
+static void fill_rect(const lcd_ui_context_t *ctx,
+		      uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+		      uint32_t colour)
+{
+	lcd_ui_rect_t rect = {x, y, w, h};
+	lcd_ui_rect_t visible;
+
+	if (!rect_intersection(&rect, &ctx->clip, &visible))
+		return;
+
+	/* Still a row-major fill on the panel whatever the rotation */
+	visible = rect_to_native(ctx, &visible);
+	ctx->driver->draw_rect(ctx->driver_instance,
+			       visible.x, visible.y,
+			       visible.width, visible.height, colour);
+}
+
+static uint8_t pixel_bytes(lcd_ui_pixel_format_t format)
+{
+	return (format == LCD_UI_PIXEL_RGB565) ? 2U : 4U;
+}
+
+/**
+ * @brief Writes a panel-oriented ARGB8888 block through the driver's
+ *        draw_bitmap, or straight into its framebuffer.
+ * @return 0 if the driver offers neither.
+ */
+static uint8_t write_pixels(const lcd_ui_context_t *ctx,
+			    const lcd_ui_rect_t *native,
+			    const uint32_t *pixels, uint16_t stride)
+{
+	lcd_ui_framebuffer_t fb;
+
+	if (ctx->driver->draw_bitmap)
+	{
+		ctx->driver->draw_bitmap(ctx->driver_instance,
+					 native->x, native->y,
+					 native->width, native->height,
+					 pixels, stride);
+		return 1U;
+	}
+
+	if (!ctx->driver->get_framebuffer ||
+	    !ctx->driver->get_framebuffer(ctx->driver_instance, &fb))
+		return 0U;
+
+	for (uint16_t row = 0U; row < native->height; ++row)
+	{
+		const uint32_t *src = pixels + (size_t)row * stride;
+		const size_t offset = (size_t)(native->y + row) * fb.stride + native->x;
+
+		if (fb.format == LCD_UI_PIXEL_RGB565)
+		{
+			convert_argb_to_rgb565(src, (uint16_t *)fb.pixels + offset,
+					       native->width);
+		}
+		else
+		{
+			memcpy((uint32_t *)fb.pixels + offset, src,
+			       (size_t)native->width * sizeof(uint32_t));
+		}
+	}
+
+	return 1U;
+}
+
+/**
+ * @brief Writes an already clipped logical ARGB8888 block, rotating it onto
+ *        the panel. A 32-bit framebuffer is rotated into directly; anything
+ *        else goes one rotated tile at a time.
+ */
+static void blit_logical(const lcd_ui_context_t *ctx,
+			 const lcd_ui_rect_t *rect,
+			 const uint32_t *pixels, uint16_t stride)
+{
+	lcd_ui_framebuffer_t fb;
+
+	if (ctx->rotation == LCD_UI_ROTATION_0)
+	{
+		(void)write_pixels(ctx, rect, pixels, stride);
+		return;
+	}
+
+	if (!ctx->driver->draw_bitmap && ctx->driver->get_framebuffer &&
+	    ctx->driver->get_framebuffer(ctx->driver_instance, &fb) &&
+	    (fb.format == LCD_UI_PIXEL_ARGB8888))
+	{
+		const lcd_ui_rect_t native = rect_to_native(ctx, rect);
+		lcd_ui_rotate_pixels(pixels, stride, rect->width, rect->height,
+				     (uint32_t *)fb.pixels + (size_t)native.y * fb.stride + native.x,
+				     fb.stride, ctx->rotation);
+		return;
+	}
+
+	uint32_t tile[LCD_UI_ROTATE_TILE * LCD_UI_ROTATE_TILE];
+
+	for (uint16_t ty = 0U; ty < rect->height; ty += LCD_UI_ROTATE_TILE)
+	{
+		for (uint16_t tx = 0U; tx < rect->width; tx += LCD_UI_ROTATE_TILE)
+		{
+			lcd_ui_rect_t part = {rect->x + tx, rect->y + ty,
+					      rect->width - tx, rect->height - ty};
+			if (part.width > LCD_UI_ROTATE_TILE)
+				part.width = LCD_UI_ROTATE_TILE;
+			if (part.height > LCD_UI_ROTATE_TILE)
+				part.height = LCD_UI_ROTATE_TILE;
+
+			const lcd_ui_rect_t native = rect_to_native(ctx, &part);
+			lcd_ui_rotate_pixels(pixels + (size_t)ty * stride + tx, stride,
+					     part.width, part.height,
+					     tile, native.width, ctx->rotation);
+			(void)write_pixels(ctx, &native, tile, native.width);
+		}
+	}
+}
+
+/**
+ * @brief Fixed-point walk from one colour to another, 16 fractional bits
+ *        per channel.
+ */
+typedef struct
+{
+	int32_t value[4];
+	int32_t step[4];
+} gradient_walk_t;
+
+/**
+ * @brief Positions @p walk @p offset pixels into a gradient @p length long.
+ */
+static void gradient_walk_start(gradient_walk_t *walk,
+				const lcd_ui_gradient_t *gradient,
+				uint16_t length, uint16_t offset)
+{
+	for (uint8_t channel = 0U; channel < 4U; ++channel)
+	{
+		const int32_t from = (int32_t)((gradient->start_colour >> (channel * 8U)) & 0xFFU);
+		const int32_t to = (int32_t)((gradient->end_colour >> (channel * 8U)) & 0xFFU);
+
+		walk->step[channel] = (length > 1U) ? ((to - from) * 65536) / (int32_t)(length - 1U) : 0;
+		/* Bias by one half so the shift below rounds */
+		walk->value[channel] = from * 65536 + walk->step[channel] * offset + 32768;
+	}
+}
+
+static uint32_t gradient_walk_next(gradient_walk_t *walk)
+{
+	uint32_t colour = 0U;
+
+	for (uint8_t channel = 0U; channel < 4U; ++channel)
+	{
+		colour |= (uint32_t)(walk->value[channel] >> 16) << (channel * 8U);
+		walk->value[channel] += walk->step[channel];
+	}
+
+	return colour;
+}
+
+/**
+ * @brief Pre-dithers an ARGB colour so that plain truncation to RGB565
+ *        lands on the dithered value.
+ */
+static uint32_t dither_pixel(uint32_t colour, uint16_t x, uint16_t y)
+{
+	return (colour & 0xFF000000U) |
+	       (rgb565_to_argb(argb_to_rgb565_dithered(colour, x, y)) & 0x00FFFFFFU);
+}
+
+/**
+ * @brief Whether blit_logical() can reach the panel, and whether what it
+ *        reaches stores RGB565.
+ */
+static uint8_t pixel_target(const lcd_ui_context_t *ctx, uint8_t *rgb565)
+{
+	lcd_ui_framebuffer_t fb;
+
+	*rgb565 = 0U;
+	if (ctx->driver->get_framebuffer &&
+	    ctx->driver->get_framebuffer(ctx->driver_instance, &fb))
+	{
+		*rgb565 = (fb.format == LCD_UI_PIXEL_RGB565);
+		return 1U;
+	}
+
+	return ctx->driver->draw_bitmap != NULL;
+}
+
+/**
+ * @brief Draws the part of a gradient spanning @p extent that lies in
+ *        @p area, clipped to ctx->clip.
+ *
+ *        Rows of a horizontal gradient are identical, so each run is
+ *        computed once and repeated down the rectangle (four rows when
+ *        dithering). Rows of a vertical gradient are flat fills unless
+ *        dithering, in which case one run per row is repeated across it.
+ *        Drivers without pixel access get one fill per column or row.
+ */
+static void fill_gradient(const lcd_ui_context_t *ctx,
+			  const lcd_ui_rect_t *extent,
+			  const lcd_ui_rect_t *area,
+			  const lcd_ui_gradient_t *gradient)
+{
+	uint32_t pattern[4U * LCD_UI_GRADIENT_SPAN];
+	lcd_ui_rect_t visible;
+	gradient_walk_t walk;
+	uint8_t rgb565;
+
+	if (!rect_intersection(area, &ctx->clip, &visible))
+		return;
+
+	const uint8_t blit = pixel_target(ctx, &rgb565);
+
+	if (gradient->direction == LCD_UI_GRADIENT_HORIZONTAL)
+	{
+		const uint16_t pattern_rows = rgb565 ? 4U : 1U;
+
+		for (uint16_t x0 = 0U; x0 < visible.width; x0 += LCD_UI_GRADIENT_SPAN)
+		{
+			const uint16_t x = visible.x + x0;
+			uint16_t span = visible.width - x0;
+			if (span > LCD_UI_GRADIENT_SPAN)
+				span = LCD_UI_GRADIENT_SPAN;
+
+			gradient_walk_start(&walk, gradient, extent->width, x - extent->x);
+
+			if (!blit)
+			{
+				for (uint16_t i = 0U; i < span; ++i)
+				{
+					fill_rect(ctx, x + i, visible.y, 1U, visible.height,
+						  gradient_walk_next(&walk));
+				}
+				continue;
+			}
+
+			for (uint16_t i = 0U; i < span; ++i)
+			{
+				const uint32_t colour = gradient_walk_next(&walk);
+				for (uint16_t row = 0U; row < pattern_rows; ++row)
+				{
+					pattern[row * LCD_UI_GRADIENT_SPAN + i] =
+					    rgb565 ? dither_pixel(colour, x + i, visible.y + row) : colour;
+				}
+			}
+
+			if (!rgb565)
+			{
+				/* A zero stride repeats the one row */
+				const lcd_ui_rect_t run = {x, visible.y, span, visible.height};
+				blit_logical(ctx, &run, pattern, 0U);
+				continue;
+			}
+
+			for (uint16_t y0 = 0U; y0 < visible.height; y0 += 4U)
+			{
+				lcd_ui_rect_t band = {x, visible.y + y0, span, visible.height - y0};
+				if (band.height > 4U)
+					band.height = 4U;
+				blit_logical(ctx, &band, pattern, LCD_UI_GRADIENT_SPAN);
+			}
+		}
+		return;
+	}
+
+	gradient_walk_start(&walk, gradient, extent->height, visible.y - extent->y);
+
+	for (uint16_t row = 0U; row < visible.height; ++row)
+	{
+		const uint32_t colour = gradient_walk_next(&walk);
+		const uint16_t y = visible.y + row;
+
+		if (!blit || !rgb565)
+		{
+			fill_rect(ctx, visible.x, y, visible.width, 1U, colour);
+			continue;
+		}
+
+		/* The dither repeats every 4 pixels, so one run serves the row */
+		const uint16_t span = (visible.width < LCD_UI_GRADIENT_SPAN) ? visible.width
+									      : LCD_UI_GRADIENT_SPAN;
+		for (uint16_t i = 0U; i < span; ++i)
+		{
+			pattern[i] = dither_pixel(colour, visible.x + i, y);
+		}
+
+		for (uint16_t x0 = 0U; x0 < visible.width; x0 += LCD_UI_GRADIENT_SPAN)
+		{
+			lcd_ui_rect_t run = {visible.x + x0, y, visible.width - x0, 1U};
+			if (run.width > LCD_UI_GRADIENT_SPAN)
+				run.width = LCD_UI_GRADIENT_SPAN;
+			blit_logical(ctx, &run, pattern, LCD_UI_GRADIENT_SPAN);
+		}
+	}
+}
+
+/**
+ * @brief Rasterises text from the driver's glyph bitmaps, for when the
+ *        driver's own text routine cannot be used (rotated screens).
+ *        Glyphs go out in bands of rows that fit one rotation tile.
+ */
+static void draw_glyphs(const lcd_ui_context_t *ctx,
+			uint16_t x, uint16_t y, const char *text,
+			uint32_t text_colour, uint32_t background_colour)
+{
+	const uint16_t font_w = ctx->driver->get_font_width(ctx->driver_instance);
+	const uint16_t font_h = ctx->driver->get_font_height(ctx->driver_instance);
+	const uint16_t row_bytes = (font_w + 7U) / 8U;
+	uint32_t band[LCD_UI_ROTATE_TILE * LCD_UI_ROTATE_TILE];
+	uint16_t band_rows;
+
+	if ((font_w == 0U) || (font_w > LCD_UI_ROTATE_TILE * LCD_UI_ROTATE_TILE))
+		return;
+
+	band_rows = (uint16_t)((LCD_UI_ROTATE_TILE * LCD_UI_ROTATE_TILE) / font_w);
+
+	for (; *text != '\0'; ++text, x += font_w)
+	{
+		const uint8_t *glyph = ctx->driver->get_glyph(ctx->driver_instance, *text);
+
+		if (glyph == NULL)
+			continue;
+
+		for (uint16_t row0 = 0U; row0 < font_h; row0 += band_rows)
+		{
+			lcd_ui_rect_t part = {x, y + row0, font_w, font_h - row0};
+			lcd_ui_rect_t visible;
+
+			if (part.height > band_rows)
+				part.height = band_rows;
+
+			for (uint16_t row = 0U; row < part.height; ++row)
+			{
+				const uint8_t *bits = glyph + (size_t)(row0 + row) * row_bytes;
+				for (uint16_t col = 0U; col < font_w; ++col)
+				{
+					band[row * font_w + col] =
+					    (bits[col / 8U] & (0x80U >> (col % 8U))) ? text_colour
+										  : background_colour;
+				}
+			}
+
+			if (rect_intersection(&part, &ctx->clip, &visible))
+			{
+				blit_logical(ctx, &visible,
+					     band + (visible.y - part.y) * font_w + (visible.x - part.x),
+					     font_w);
+			}
+		}
+	}
+}
+
+/**
+ * @brief Draws text through the driver. Its glyphs cannot be clipped, so
+ *        the string is drawn whole when it touches ctx->clip and fits
+ *        inside ctx->scissor, and skipped otherwise. Rotated text is
+ *        rasterised here from get_glyph and clipped exactly.
+ */
+static void draw_text(const lcd_ui_context_t *ctx,
+		      uint16_t x, uint16_t y, const char *text,
+		      uint32_t text_colour, uint32_t background_colour,
+		      lcd_ui_align_t align)
+{
+	lcd_ui_rect_t box = {x, y, 0U, ctx->driver->get_font_height(ctx->driver_instance)};
+
+	if (align == LCD_UI_ALIGN_LEFT)
+	{
+		box.width = (uint16_t)(strlen(text) *
+				       ctx->driver->get_font_width(ctx->driver_instance));
+	}
+	else
+	{
+		/* The driver positions non-left text relative to the whole line */
+		box.x = 0U;
+		box.width = ctx->screen_width;
+	}
+
+	if (!rect_intersects(&box, &ctx->clip))
+		return;
+
+	if (ctx->rotation == LCD_UI_ROTATION_0)
+	{
+		if (rect_contains(&ctx->scissor, &box))
+		{
+			ctx->driver->draw_text(ctx->driver_instance, x, y, text,
+					       text_colour, background_colour, align);
+		}
+	}
+	else if (ctx->driver->get_glyph)
+	{
+		const uint16_t font_w = ctx->driver->get_font_width(ctx->driver_instance);
+		const uint16_t text_w = (uint16_t)(strlen(text) * font_w);
+
+		if (text_w < ctx->screen_width)
+		{
+			if (align == LCD_UI_ALIGN_CENTER)
+				x = x + (ctx->screen_width - text_w) / 2U;
+			else if (align == LCD_UI_ALIGN_RIGHT)
+				x = ctx->screen_width - text_w - x;
+		}
+
+		draw_glyphs(ctx, x, y, text, text_colour, background_colour);
+	}
+}
+
+/**
+ * @brief Works out the screen area a widget draws into and whether the
+ *        draw fully overwrites it.
+ */
+static void widget_bounds(const lcd_ui_context_t *context,
+			  const lcd_ui_widget_t *widget,
+			  lcd_ui_rect_t *bounds,
+			  uint8_t *opaque)
+{
+	bounds->x = widget->x;
+	bounds->y = widget->y;
+	bounds->width = widget->width;
+	bounds->height = widget->height;
+	*opaque = 1U;
+
+	if (widget->type == LCD_UI_WIDGET_LABEL)
+	{
+		/* The driver positions non-left text relative to the whole line */
+		*opaque = 0U;
+		bounds->height = context->driver->get_font_height(context->driver_instance);
+
+		if (widget->text_align != LCD_UI_ALIGN_LEFT)
+		{
+			bounds->x = 0U;
+			bounds->width = context->screen_width;
+		}
+		else if (widget->label_text != NULL)
+		{
+			bounds->width = (uint16_t)(strlen(widget->label_text) *
+						   context->driver->get_font_width(context->driver_instance));
+		}
+	}
+}
+
 void lcd_ui_init(lcd_ui_context_t *ctx,
 		 const lcd_ui_driver_t *driver,
+		 void *driver_instance,
 		 lcd_ui_widget_t **widget_buffer,
 		 uint8_t capacity)
 {
-	if (!ctx || !driver || !widget_buffer)
+	if (!ctx || !driver || !widget_buffer)
+		return;
+
+	ctx->driver = driver;
+	ctx->driver_instance = driver_instance;
+	ctx->widgets = widget_buffer;
+	ctx->widget_capacity = capacity;
+	ctx->widget_count = 0;
+
+	ctx->active_widget = NULL;
+	ctx->touch_active = 0;
+	ctx->pressed_widget = NULL;
+
+	ctx->press_time_us = 0U;
+	ctx->feedback_latency_us = 0U;
+	ctx->feedback_latency_max_us = 0U;
+	ctx->feedback_pending = 0U;
+
+	ctx->background_colour = colour_black;
+	ctx->overlays = NULL;
+	ctx->drawing_widget = NULL;
+
+	ctx->styles = NULL;
+	ctx->style_count = 0U;
+	ctx->theme_version = 0U;
+
+	ctx->damage_count = 0U;
+	ctx->stale_count = 0U;
+
+	driver->init(driver_instance);
+	driver->get_screen_size(driver_instance, &ctx->native_width, &ctx->native_height);
+
+	ctx->rotation = LCD_UI_ROTATION_0;
+	ctx->screen_width = ctx->native_width;
+	ctx->screen_height = ctx->native_height;
+
+	ctx->clip.x = 0U;
+	ctx->clip.y = 0U;
+	ctx->clip.width = ctx->screen_width;
+	ctx->clip.height = ctx->screen_height;
+	ctx->scissor = ctx->clip;
+}
+
+void lcd_ui_reset_screen(lcd_ui_context_t *ctx, uint32_t colour)
+{
+	if (!ctx || !ctx->driver)
+		return;
+
+	lcd_ui_rect_t screen = {0U, 0U, ctx->screen_width, ctx->screen_height};
+	begin_draw(ctx, &screen, 1U);
+
+	ctx->driver->clear(ctx->driver_instance, colour);
+	ctx->background_colour = colour;
+	lcd_ui_clear_widgets(ctx);
+}
+
+void lcd_ui_clear_widgets(lcd_ui_context_t *ctx)
+{
+	if (!ctx)
+		return;
+
+	ctx->widget_count = 0;
+	ctx->overlays = NULL;
+	ctx->active_widget = NULL;
+	ctx->pressed_widget = NULL;
+	ctx->feedback_pending = 0U;
+
+	for (uint8_t i = 0; i < ctx->widget_capacity; ++i)
+	{
+		ctx->widgets[i] = NULL;
+	}
+}
+void lcd_ui_add_widget(lcd_ui_context_t *ctx,
+		       const lcd_ui_widget_t *widget)
+{
+	if (!ctx || !widget)
+		return;
+
+	if (ctx->widget_count >= ctx->widget_capacity)
+		return;
+
+	ctx->widgets[ctx->widget_count++] = (lcd_ui_widget_t *)widget;
+
+	if (widget->text_align > LCD_UI_ALIGN_RIGHT)
+	{
+		ctx->widgets[ctx->widget_count]->text_align = LCD_UI_ALIGN_LEFT;
+	}
+}
+
+/**
+ * @brief The theme style a widget uses, or NULL for its own colours.
+ */
+static const lcd_ui_style_t *widget_style(const lcd_ui_context_t *ctx,
+					  const lcd_ui_widget_t *widget)
+{
+	if (!ctx->styles || (widget->style == 0U) || (widget->style > ctx->style_count))
+		return NULL;
+
+	return &ctx->styles[widget->style - 1U];
+}
+
+/**
+ * @brief Internal utility to render a single widget.
+ *        Used by both full render and selective redraw.
+ * @note AI-aided via Supermaven Copilot — reviewed and adapted.
+ */
+static void draw_widget(lcd_ui_context_t *context,
+			const lcd_ui_widget_t *widget)
+{
+	if (!context || !context->driver || !widget)
+		return;
+
+	const lcd_ui_widget_t *outer_widget = context->drawing_widget;
+	lcd_ui_rect_t bounds;
+	uint8_t opaque;
+
+	const lcd_ui_style_t *style = widget_style(context, widget);
+	uint32_t background = style ? style->background : widget->background_color;
+	const uint32_t foreground = style ? style->text : widget->text_color;
+	const uint16_t margin = style ? style->margin : 0U;
+
+	context->drawing_widget = widget;
+	widget_bounds(context, widget, &bounds, &opaque);
+	begin_draw(context, &bounds, opaque);
+
+	switch (widget->type)
+	{
+	case LCD_UI_WIDGET_BUTTON:
+	{
+		const uint8_t pressed = (widget == context->pressed_widget);
+
+		if (pressed)
+		{
+			background = style ? style->shades.pressed
+					   : darken_colour(widget->background_color, 20U);
+		}
+
+		if (widget->gradient && !pressed)
+		{
+			const lcd_ui_rect_t face = {widget->x, widget->y,
+						    widget->width, widget->height};
+			fill_gradient(context, &face, &face, widget->gradient);
+		}
+		else
+		{
+			fill_rect(context,
+				  widget->x,
+				  widget->y,
+				  widget->width,
+				  widget->height,
+				  background);
+		}
+
+		if (widget->label_text != NULL)
+		{
+			uint16_t font_w = context->driver->get_font_width(context->driver_instance);
+			uint16_t font_h = context->driver->get_font_height(context->driver_instance);
+
+			uint16_t text_len = (uint16_t)strlen(widget->label_text);
+			uint16_t text_width = text_len * font_w;
+
+			uint16_t text_x;
+			switch (widget->text_align)
+			{
+			case LCD_UI_ALIGN_CENTER:
+				text_x = widget->x + (widget->width - text_width) / 2U;
+				break;
+			case LCD_UI_ALIGN_RIGHT:
+				text_x = widget->x + widget->width - text_width - margin;
+				break;
+			case LCD_UI_ALIGN_LEFT:
+			default:
+				text_x = widget->x + margin;
+				break;
+			}
+
+			uint16_t text_y = widget->y + (widget->height - font_h) / 2U;
+
+			draw_text(context,
+				  text_x,
+				  text_y,
+				  widget->label_text,
+				  foreground,
+				  background,
+				  LCD_UI_ALIGN_LEFT); // force manual alignment
+		}
+		break;
+	}
+
+	case LCD_UI_WIDGET_LABEL:
+		if (widget->label_text != NULL)
+		{
+			draw_text(context,
+				  widget->x,
+				  widget->y,
+				  widget->label_text,
+				  foreground,
+				  background,
+				  (lcd_ui_align_t)widget->text_align);
+		}
+		break;
+
+	case LCD_UI_WIDGET_PROGRESS_BAR:
+	{
+		fill_rect(context,
+			  widget->x,
+			  widget->y,
+			  widget->width,
+			  widget->height,
+			  background);
+
+		uint16_t fill_width =
+		    (uint16_t)((widget->progress_percent * widget->width) / 100U);
+
+		if (widget->gradient)
+		{
+			/* The gradient spans the whole bar; progress reveals it */
+			const lcd_ui_rect_t bar = {widget->x, widget->y,
+						   widget->width, widget->height};
+			const lcd_ui_rect_t filled = {widget->x, widget->y,
+						      fill_width, widget->height};
+			fill_gradient(context, &bar, &filled, widget->gradient);
+		}
+		else
+		{
+			fill_rect(context,
+				  widget->x,
+				  widget->y,
+				  fill_width,
+				  widget->height,
+				  foreground);
+		}
+		break;
+	}
+
+	case LCD_UI_WIDGET_CHART:
+		lcd_ui_chart_draw(context, widget, background, foreground);
+		break;
+
+	case LCD_UI_WIDGET_LIST:
+		lcd_ui_list_draw(context, widget, background, foreground);
+		break;
+
+	case LCD_UI_WIDGET_TABLE:
+		lcd_ui_table_draw(context, widget, background, foreground);
+		break;
+
+	case LCD_UI_WIDGET_IMAGE:
+		lcd_ui_image_draw(context, widget, background);
+		break;
+
+	case LCD_UI_WIDGET_GAUGE:
+		lcd_ui_gauge_draw(context, widget, background, foreground);
+		break;
+
+	case LCD_UI_WIDGET_KEYBOARD:
+		lcd_ui_keyboard_draw(context, widget, background, foreground);
+		break;
+
+	case LCD_UI_WIDGET_SLIDER:
+	{
+		const uint16_t knob_size = widget->height; // square knob
+		const uint16_t track_height = widget->height / 3U;
+		const uint16_t track_y = widget->y + (widget->height - track_height) / 2U;
+
+		/* Clear the entire slider widget area first */
+		fill_rect(context,
+			  widget->x,
+			  widget->y,
+			  widget->width,
+			  widget->height,
+			  background);
+
+		/* Draw the slider track using text_color */
+		fill_rect(context,
+			  widget->x,
+			  track_y,
+			  widget->width,
+			  track_height,
+			  foreground); // Track color
+
+		/* Compute knob position */
+		uint16_t usable_width = widget->width - knob_size;
+		uint16_t knob_x = widget->x + (widget->slider_value * usable_width) / 100U;
+
+		/* Clamp knob_x to ensure knob stays within widget bounds */
+		if (knob_x + knob_size > widget->x + widget->width)
+		{
+			knob_x = widget->x + widget->width - knob_size;
+		}
+
+		/* Knob color: lighter version of text_color, precomputed by styles */
+		uint32_t knob_color = style ? style->shades.accent
+					    : lighten_colour(foreground, 40U);
+
+		/* Draw the knob (square) */
+		fill_rect(context,
+			  knob_x,
+			  widget->y,
+			  knob_size,
+			  knob_size,
+			  knob_color); // Knob
+
+		break;
+	}
+
+	default:
+		break;
+	}
+
+	context->drawing_widget = outer_widget;
+}
+
+/**
+ * @brief Redraws, clipped to @p area, every listed widget from position
+ *        @p first upwards that touches it, putting them back on top of
+ *        something just drawn beneath them.
+ */
+static void draw_above(lcd_ui_context_t *ctx, int16_t first,
+		       const lcd_ui_rect_t *area)
+{
+	const lcd_ui_rect_t saved_clip = ctx->clip;
+
+	if (first < 0)
+		first = 0;
+
+	if (rect_intersection(area, &saved_clip, &ctx->clip))
+	{
+		for (uint8_t i = (uint8_t)first; i < ctx->widget_count; ++i)
+		{
+			lcd_ui_rect_t bounds;
+			uint8_t opaque;
+
+			widget_bounds(ctx, ctx->widgets[i], &bounds, &opaque);
+			if (rect_intersects(&bounds, &ctx->clip))
+			{
+				draw_widget(ctx, ctx->widgets[i]);
+			}
+		}
+	}
+
+	ctx->clip = saved_clip;
+}
+
+void lcd_ui_render(lcd_ui_context_t *ctx)
+{
+	if (!ctx || !ctx->driver)
+		return;
+
+	for (uint8_t i = 0; i < ctx->widget_count; ++i)
+	{
+		draw_widget(ctx, ctx->widgets[i]);
+	}
+}
+
+void lcd_ui_redraw_widget(lcd_ui_context_t *context,
+			  const lcd_ui_widget_t *widget)
+{
+	draw_widget(context, widget);
+
+	if (!context || !context->driver || !widget)
+		return;
+
+	/* Keep anything above on top: overlays, or widgets animated over it */
+	int16_t first = widget_z(context, widget) + 1;
+
+	if ((first != 0) || context->overlays)
+	{
+		lcd_ui_rect_t bounds;
+		uint8_t opaque;
+
+		if (first == 0)
+		{
+			/* Unlisted widgets sit beneath the list; lift only the overlays */
+			first = (int16_t)context->widget_count;
+			for (const lcd_ui_overlay_t *overlay = context->overlays; overlay; overlay = overlay->next)
+			{
+				int16_t overlay_z = widget_z(context, overlay->widget);
+				if ((overlay_z >= 0) && (overlay_z < first))
+					first = overlay_z;
+			}
+		}
+
+		widget_bounds(context, widget, &bounds, &opaque);
+		draw_above(context, first, &bounds);
+	}
+}
+
+/**
+ * @brief Notes the time from the last press to now as feedback latency.
+ */
+static void record_feedback(lcd_ui_context_t *ctx)
+{
+	ctx->feedback_pending = 0U;
+
+	if (!ctx->driver->get_time_us)
 		return;
 
-	ctx->driver = driver;
-	ctx->widgets = widget_buffer;
-	ctx->widget_capacity = capacity;
-	ctx->widget_count = 0;
+	ctx->feedback_latency_us = ctx->driver->get_time_us(ctx->driver_instance) - ctx->press_time_us;
+	if (ctx->feedback_latency_us > ctx->feedback_latency_max_us)
+		ctx->feedback_latency_max_us = ctx->feedback_latency_us;
+}
 
-	ctx->active_widget = NULL;
-	ctx->touch_active = 0;
+void lcd_ui_present(lcd_ui_context_t *ctx)
+{
+	if (!ctx || !ctx->driver)
+		return;
+
+	if (ctx->driver->flip)
+	{
+		/* Anything left over from the previous flip must land first */
+		flush_stale(ctx);
 
-	driver->init();
-	driver->get_screen_size(&ctx->screen_width, &ctx->screen_height);
+		ctx->driver->flip(ctx->driver_instance);
+
+		/* The new back buffer is the frame shown before this flip, so
+		   it is missing exactly what was drawn this frame. */
+		memcpy(ctx->stale, ctx->damage, sizeof(ctx->damage));
+		ctx->stale_count = ctx->damage_count;
+
+		if (ctx->feedback_pending)
+			record_feedback(ctx);
+	}
+
+	ctx->damage_count = 0U;
 }
 
-void lcd_ui_reset_screen(lcd_ui_context_t *ctx, uint32_t colour)
+/**
+ * @brief Moves a logical block of pixels within the draw target, through the
+ *        driver when it can, otherwise with memmove() on the framebuffer.
+ * @return 0 if the driver offers neither.
+ */
+static uint8_t move_pixels(const lcd_ui_context_t *ctx,
+			   uint16_t src_x, uint16_t src_y,
+			   uint16_t w, uint16_t h,
+			   uint16_t dst_x, uint16_t dst_y)
+{
+	lcd_ui_framebuffer_t fb;
+	const lcd_ui_rect_t logical_src = {src_x, src_y, w, h};
+	const lcd_ui_rect_t logical_dst = {dst_x, dst_y, w, h};
+	const lcd_ui_rect_t native_src = rect_to_native(ctx, &logical_src);
+	const lcd_ui_rect_t native_dst = rect_to_native(ctx, &logical_dst);
+
+	/* A rotation keeps a translation a translation, just along other axes */
+	src_x = native_src.x;
+	src_y = native_src.y;
+	dst_x = native_dst.x;
+	dst_y = native_dst.y;
+	w = native_src.width;
+	h = native_src.height;
+
+	if (ctx->driver->copy_rect)
+	{
+		ctx->driver->copy_rect(ctx->driver_instance, src_x, src_y, w, h, dst_x, dst_y);
+		return 1U;
+	}
+
+	if (!ctx->driver->get_framebuffer ||
+	    !ctx->driver->get_framebuffer(ctx->driver_instance, &fb))
+		return 0U;
+
+	const size_t bpp = pixel_bytes(fb.format);
+	const size_t pitch = (size_t)fb.stride * bpp;
+	const size_t row_bytes = (size_t)w * bpp;
+	uint8_t *src = (uint8_t *)fb.pixels + src_y * pitch + src_x * bpp;
+	uint8_t *dst = (uint8_t *)fb.pixels + dst_y * pitch + dst_x * bpp;
+
+	if (dst_y > src_y)
+	{
+		/* Moving down: walk rows bottom-up so no source row is overwritten first */
+		for (uint16_t row = h; row-- > 0U;)
+		{
+			memmove(dst + row * pitch, src + row * pitch, row_bytes);
+		}
+	}
+	else
+	{
+		for (uint16_t row = 0U; row < h; ++row)
+		{
+			memmove(dst + row * pitch, src + row * pitch, row_bytes);
+		}
+	}
+
+	return 1U;
+}
+
+/**
+ * @brief Repaints everything inside @p area: background first, then every
+ *        widget touching it in z-order, with fills clipped to the area.
+ *        Whatever lies under an opaque widget covering the whole area is
+ *        skipped, so moving panels do not flash the background.
+ */
+static void repaint_area(lcd_ui_context_t *ctx,
+			 const lcd_ui_rect_t *area,
+			 uint32_t background_colour)
+{
+	const lcd_ui_rect_t saved_clip = ctx->clip;
+
+	if (rect_intersection(area, &ctx->scissor, &ctx->clip))
+	{
+		uint8_t first = 0U;
+		uint8_t covered = 0U;
+
+		for (uint8_t i = ctx->widget_count; (i > 0U) && !covered; --i)
+		{
+			lcd_ui_rect_t bounds;
+			uint8_t opaque;
+
+			widget_bounds(ctx, ctx->widgets[i - 1U], &bounds, &opaque);
+			if (opaque && rect_contains(&bounds, &ctx->clip))
+			{
+				first = (uint8_t)(i - 1U);
+				covered = 1U;
+			}
+		}
+
+		if (!covered)
+		{
+			begin_draw(ctx, &ctx->clip, 1U);
+			fill_rect(ctx, ctx->clip.x, ctx->clip.y,
+				  ctx->clip.width, ctx->clip.height, background_colour);
+		}
+
+		for (uint8_t i = first; i < ctx->widget_count; ++i)
+		{
+			lcd_ui_rect_t bounds;
+			uint8_t opaque;
+
+			widget_bounds(ctx, ctx->widgets[i], &bounds, &opaque);
+			if (rect_intersects(&bounds, &ctx->clip))
+			{
+				draw_widget(ctx, ctx->widgets[i]);
+			}
+		}
+	}
+
+	ctx->clip = saved_clip;
+}
+
+/**
+ * @brief Whether widget @p index stays put while @p area scrolls beneath
+ *        it: an overlay, or a widget listed above scrolled content (a
+ *        widget wholly inside @p area) that it covers.
+ */
+static uint8_t is_floating(const lcd_ui_context_t *ctx, uint8_t index,
+			   const lcd_ui_rect_t *bounds, const lcd_ui_rect_t *area)
+{
+	for (const lcd_ui_overlay_t *overlay = ctx->overlays; overlay; overlay = overlay->next)
+	{
+		if (overlay->widget == ctx->widgets[index])
+			return 1U;
+	}
+
+	for (uint8_t i = 0U; i < index; ++i)
+	{
+		lcd_ui_rect_t content;
+		uint8_t opaque;
+
+		widget_bounds(ctx, ctx->widgets[i], &content, &opaque);
+		if (rect_contains(area, &content) && rect_intersects(bounds, &content))
+			return 1U;
+	}
+
+	return 0U;
+}
+
+void lcd_ui_scroll_region(lcd_ui_context_t *ctx,
+			  const lcd_ui_rect_t *region,
+			  int16_t dx, int16_t dy,
+			  uint32_t background_colour)
+{
+	if (!ctx || !ctx->driver || !region)
+		return;
+
+	lcd_ui_rect_t area = *region;
+	if (!rect_clip_to_screen(ctx, &area))
+		return;
+
+	const lcd_ui_rect_t saved_scissor = ctx->scissor;
+	const uint16_t shift_x = (uint16_t)((dx < 0) ? -dx : dx);
+	const uint16_t shift_y = (uint16_t)((dy < 0) ? -dy : dy);
+
+	ctx->scissor = area;
+
+	/* Anything stale under the region must be current before it moves */
+	begin_draw(ctx, &area, 0U);
+
+	if ((shift_x >= area.width) || (shift_y >= area.height) ||
+	    !move_pixels(ctx,
+			 (dx < 0) ? (area.x + shift_x) : area.x,
+			 (dy < 0) ? (area.y + shift_y) : area.y,
+			 area.width - shift_x,
+			 area.height - shift_y,
+			 (dx > 0) ? (area.x + shift_x) : area.x,
+			 (dy > 0) ? (area.y + shift_y) : area.y))
+	{
+		repaint_area(ctx, &area, background_colour);
+		ctx->scissor = saved_scissor;
+		return;
+	}
+
+	if (shift_y != 0U)
+	{
+		lcd_ui_rect_t rows = {area.x,
+				      (dy > 0) ? area.y : (area.y + area.height - shift_y),
+				      area.width,
+				      shift_y};
+		repaint_area(ctx, &rows, background_colour);
+	}
+
+	if (shift_x != 0U)
+	{
+		lcd_ui_rect_t columns = {(dx > 0) ? area.x : (area.x + area.width - shift_x),
+					 (dy > 0) ? (area.y + shift_y) : area.y,
+					 shift_x,
+					 area.height - shift_y};
+		repaint_area(ctx, &columns, background_colour);
+	}
+
+	/* What lies beneath an overlay has moved, so its save-under is stale */
+	for (lcd_ui_overlay_t *overlay = ctx->overlays; overlay; overlay = overlay->next)
+	{
+		if (rect_intersects(&overlay->area, &area))
+			overlay->saved = 0U;
+	}
+
+	/*
+	 * Widgets crossing the region edge, and widgets floating over the
+	 * scrolled content, had their pixels dragged along. A floating widget
+	 * is repainted where it is and where its pixels were dragged to.
+	 */
+	for (uint8_t i = 0U; i < ctx->widget_count; ++i)
+	{
+		lcd_ui_rect_t bounds;
+		lcd_ui_rect_t inside;
+		lcd_ui_rect_t ghost;
+		uint8_t opaque;
+
+		widget_bounds(ctx, ctx->widgets[i], &bounds, &opaque);
+		if (!rect_intersection(&bounds, &area, &inside))
+			continue;
+
+		const uint8_t floating = is_floating(ctx, i, &bounds, &area);
+
+		if (floating && rect_offset(&inside, dx, dy, &ghost) &&
+		    rect_intersection(&ghost, &area, &ghost))
+		{
+			repaint_area(ctx, &ghost, background_colour);
+		}
+
+		if (floating || !rect_contains(&area, &bounds))
+			repaint_area(ctx, &inside, background_colour);
+	}
+
+	ctx->scissor = saved_scissor;
+}
+
+uint8_t lcd_ui_move_pixels(lcd_ui_context_t *ctx,
+			   const lcd_ui_rect_t *area,
+			   int16_t dx, int16_t dy)
 {
+	if (!ctx || !ctx->driver || !area)
+		return 0U;
+
+	if (!ctx->driver->copy_rect && !ctx->driver->get_framebuffer)
+		return 0U;
+
+	lcd_ui_rect_t source = *area;
+	if (!rect_clip_to_screen(ctx, &source))
+		return 1U;
+
+	/* Trim the source so the destination stays on screen */
+	const int32_t left = ((source.x + dx) > 0) ? (source.x + dx) : 0;
+	const int32_t top = ((source.y + dy) > 0) ? (source.y + dy) : 0;
+	int32_t right = source.x + source.width + dx;
+	int32_t bottom = source.y + source.height + dy;
+
+	if (right > ctx->screen_width)
+		right = ctx->screen_width;
+	if (bottom > ctx->screen_height)
+		bottom = ctx->screen_height;
+	if ((left >= right) || (top >= bottom))
+		return 1U;
+
+	source.x = (uint16_t)(left - dx);
+	source.y = (uint16_t)(top - dy);
+	source.width = (uint16_t)(right - left);
+	source.height = (uint16_t)(bottom - top);
+
+	const lcd_ui_rect_t destination = {(uint16_t)left, (uint16_t)top, source.width, source.height};
+	const lcd_ui_rect_t touched = rect_union(&source, &destination);
+
+	/* Anything stale under either block must be current before it moves */
+	begin_draw(ctx, &touched, 0U);
+
+	return move_pixels(ctx, source.x, source.y, source.width, source.height,
+			   destination.x, destination.y);
+}
+
+void lcd_ui_repaint_area(lcd_ui_context_t *ctx, const lcd_ui_rect_t *area)
+{
+	if (!ctx || !ctx->driver || !area)
+		return;
+
+	repaint_area(ctx, area, ctx->background_colour);
+}
+
+uint8_t lcd_ui_show_overlay(lcd_ui_context_t *ctx,
+			    lcd_ui_overlay_t *overlay,
+			    lcd_ui_widget_t *widget,
+			    void *save_buffer,
+			    size_t save_buffer_size)
+{
+	lcd_ui_framebuffer_t fb;
+	uint8_t opaque;
+
+	if (!ctx || !ctx->driver || !overlay || !widget)
+		return 0U;
+
+	/* Already up: saving again would capture the overlay itself */
+	for (const lcd_ui_overlay_t *shown = ctx->overlays; shown; shown = shown->next)
+	{
+		if (shown == overlay)
+		{
+			draw_widget(ctx, overlay->widget);
+			return 1U;
+		}
+	}
+
+	if (ctx->widget_count >= ctx->widget_capacity)
+		return 0U;
+
+	overlay->widget = widget;
+	overlay->save_buffer = save_buffer;
+	overlay->save_buffer_size = save_buffer_size;
+	overlay->saved = 0U;
+
+	widget_bounds(ctx, widget, &overlay->area, &opaque);
+	if (!rect_clip_to_screen(ctx, &overlay->area))
+	{
+		overlay->area.width = 0U;
+		overlay->area.height = 0U;
+	}
+
+	if ((save_buffer != NULL) && !rect_is_empty(&overlay->area) &&
+	    ctx->driver->get_framebuffer &&
+	    ctx->driver->get_framebuffer(ctx->driver_instance, &fb))
+	{
+		const lcd_ui_rect_t native = rect_to_native(ctx, &overlay->area);
+		const size_t bpp = pixel_bytes(fb.format);
+		const size_t row_bytes = (size_t)native.width * bpp;
+
+		if (row_bytes * native.height <= save_buffer_size)
+		{
+			/* A stale back buffer must be brought up to date before reading */
+			sync_stale_under(ctx, &native, 0U);
+
+			for (uint16_t row = 0U; row < native.height; ++row)
+			{
+				memcpy((uint8_t *)save_buffer + row * row_bytes,
+				       (const uint8_t *)fb.pixels +
+					   ((size_t)(native.y + row) * fb.stride + native.x) * bpp,
+				       row_bytes);
+			}
+			overlay->saved = 1U;
+		}
+	}
+
+	ctx->widgets[ctx->widget_count++] = widget;
+	overlay->next = ctx->overlays;
+	ctx->overlays = overlay;
+
+	draw_widget(ctx, widget);
+	return 1U;
+}
+
+void lcd_ui_hide_overlay(lcd_ui_context_t *ctx, lcd_ui_overlay_t *overlay)
+{
+	lcd_ui_overlay_t **link;
+	lcd_ui_framebuffer_t fb;
+	int16_t z;
+
+	if (!ctx || !ctx->driver || !overlay)
+		return;
+
+	for (link = &ctx->overlays; (*link != NULL) && (*link != overlay); link = &(*link)->next)
+	{
+	}
+
+	if (*link == NULL)
+		return;
+
+	*link = overlay->next;
+
+	/* Take the widget out of the draw order */
+	z = widget_z(ctx, overlay->widget);
+	if (z >= 0)
+	{
+		for (uint8_t i = (uint8_t)z; i + 1U < ctx->widget_count; ++i)
+		{
+			ctx->widgets[i] = ctx->widgets[i + 1U];
+		}
+		ctx->widgets[--ctx->widget_count] = NULL;
+	}
+
+	if (ctx->active_widget == overlay->widget)
+	{
+		ctx->active_widget = NULL;
+	}
+
+	if (rect_is_empty(&overlay->area))
+		return;
+
+	if (!overlay->saved ||
+	    !ctx->driver->get_framebuffer ||
+	    !ctx->driver->get_framebuffer(ctx->driver_instance, &fb))
+	{
+		repaint_area(ctx, &overlay->area, ctx->background_colour);
+		return;
+	}
+
+	const lcd_ui_rect_t saved_clip = ctx->clip;
+	const lcd_ui_rect_t native = rect_to_native(ctx, &overlay->area);
+	const size_t bpp = pixel_bytes(fb.format);
+	const size_t row_bytes = (size_t)native.width * bpp;
+
+	/* The saved pixels cover the whole area, whatever the current clip */
+	ctx->clip = overlay->area;
+	begin_draw(ctx, &overlay->area, 1U);
+	ctx->clip = saved_clip;
+
+	for (uint16_t row = 0U; row < native.height; ++row)
+	{
+		memcpy((uint8_t *)fb.pixels +
+			   ((size_t)(native.y + row) * fb.stride + native.x) * bpp,
+		       (const uint8_t *)overlay->save_buffer + row * row_bytes,
+		       row_bytes);
+	}
+
+	/* Anything shown after this overlay still belongs on top */
+	draw_above(ctx, (z >= 0) ? z : (int16_t)ctx->widget_count, &overlay->area);
+}
+
+void lcd_ui_set_rotation(lcd_ui_context_t *ctx, lcd_ui_rotation_t rotation)
+{
+	if (!ctx || (rotation > LCD_UI_ROTATION_270))
+		return;
+
+	ctx->rotation = rotation;
+
+	/* Saved pixels are laid out for the old orientation */
+	for (lcd_ui_overlay_t *overlay = ctx->overlays; overlay; overlay = overlay->next)
+	{
+		overlay->saved = 0U;
+	}
+
+	if ((rotation == LCD_UI_ROTATION_90) || (rotation == LCD_UI_ROTATION_270))
+	{
+		ctx->screen_width = ctx->native_height;
+		ctx->screen_height = ctx->native_width;
+	}
+	else
+	{
+		ctx->screen_width = ctx->native_width;
+		ctx->screen_height = ctx->native_height;
+	}
+
+	ctx->clip.x = 0U;
+	ctx->clip.y = 0U;
+	ctx->clip.width = ctx->screen_width;
+	ctx->clip.height = ctx->screen_height;
+	ctx->scissor = ctx->clip;
+}
+
+void lcd_ui_draw_bitmap(lcd_ui_context_t *ctx,
+			uint16_t x, uint16_t y,
+			uint16_t w, uint16_t h,
+			const uint32_t *pixels, uint16_t stride)
+{
+	lcd_ui_rect_t rect = {x, y, w, h};
+	lcd_ui_rect_t visible;
+
+	if (!ctx || !ctx->driver || !pixels)
+		return;
+
+	if (!rect_intersection(&rect, &ctx->clip, &visible))
+		return;
+
+	begin_draw(ctx, &visible, 1U);
+	blit_logical(ctx, &visible,
+		     pixels + (size_t)(visible.y - y) * stride + (visible.x - x),
+		     stride);
+}
+
+void lcd_ui_draw_rgb565(lcd_ui_context_t *ctx,
+			uint16_t x, uint16_t y,
+			uint16_t w, uint16_t h,
+			const uint16_t *pixels, uint16_t stride)
+{
+	lcd_ui_rect_t rect = {x, y, w, h};
+	lcd_ui_rect_t visible;
+	lcd_ui_framebuffer_t fb;
+
+	if (!ctx || !ctx->driver || !pixels)
+		return;
+
+	if (!rect_intersection(&rect, &ctx->clip, &visible))
+		return;
+
+	begin_draw(ctx, &visible, 1U);
+	pixels += (size_t)(visible.y - y) * stride + (visible.x - x);
+
+	if ((ctx->rotation == LCD_UI_ROTATION_0) && !ctx->driver->draw_bitmap &&
+	    ctx->driver->get_framebuffer &&
+	    ctx->driver->get_framebuffer(ctx->driver_instance, &fb) &&
+	    (fb.format == LCD_UI_PIXEL_RGB565))
+	{
+		/* Same format: a plain copy per row */
+		for (uint16_t row = 0U; row < visible.height; ++row)
+		{
+			memcpy((uint16_t *)fb.pixels + (size_t)(visible.y + row) * fb.stride + visible.x,
+			       pixels + (size_t)row * stride,
+			       (size_t)visible.width * sizeof(uint16_t));
+		}
+		return;
+	}
+
+	uint32_t tile[LCD_UI_ROTATE_TILE * LCD_UI_ROTATE_TILE];
+
+	for (uint16_t ty = 0U; ty < visible.height; ty += LCD_UI_ROTATE_TILE)
+	{
+		for (uint16_t tx = 0U; tx < visible.width; tx += LCD_UI_ROTATE_TILE)
+		{
+			lcd_ui_rect_t part = {visible.x + tx, visible.y + ty,
+					      visible.width - tx, visible.height - ty};
+			if (part.width > LCD_UI_ROTATE_TILE)
+				part.width = LCD_UI_ROTATE_TILE;
+			if (part.height > LCD_UI_ROTATE_TILE)
+				part.height = LCD_UI_ROTATE_TILE;
+
+			for (uint16_t row = 0U; row < part.height; ++row)
+			{
+				convert_rgb565_to_argb(pixels + (size_t)(ty + row) * stride + tx,
+						       tile + row * part.width, part.width);
+			}
+			blit_logical(ctx, &part, tile, part.width);
+		}
+	}
+}
+
+void lcd_ui_fill_rect(lcd_ui_context_t *ctx,
+		      uint16_t x, uint16_t y,
+		      uint16_t w, uint16_t h,
+		      uint32_t colour)
+{
+	const lcd_ui_rect_t rect = {x, y, w, h};
+
 	if (!ctx || !ctx->driver)
 		return;
-	ctx->driver->clear(colour);
-	lcd_ui_clear_widgets(ctx);
+
+	begin_draw(ctx, &rect, 1U);
+	fill_rect(ctx, x, y, w, h, colour);
 }
 
-void lcd_ui_clear_widgets(lcd_ui_context_t *ctx)
+/**
+ * @brief Writes one panel-oriented span (a row, or a column when the
+ *        screen is rotated a quarter turn) straight into a framebuffer.
+ */
+static void write_span(const lcd_ui_framebuffer_t *fb, const lcd_ui_rect_t *native,
+		       uint32_t colour)
 {
-	if (!ctx)
-		return;
+	const size_t offset = (size_t)native->y * fb->stride + native->x;
+	const uint16_t count = (native->height == 1U) ? native->width : native->height;
+	const size_t step = (native->height == 1U) ? 1U : fb->stride;
 
-	ctx->widget_count = 0;
+	if (fb->format == LCD_UI_PIXEL_RGB565)
+	{
+		const uint16_t value = argb_to_rgb565(colour);
+		uint16_t *dst = (uint16_t *)fb->pixels + offset;
 
-	for (uint8_t i = 0; i < ctx->widget_capacity; ++i)
+		for (uint16_t i = 0U; i < count; ++i, dst += step)
+			*dst = value;
+	}
+	else
 	{
-		ctx->widgets[i] = NULL;
+		uint32_t *dst = (uint32_t *)fb->pixels + offset;
+
+		for (uint16_t i = 0U; i < count; ++i, dst += step)
+			*dst = colour;
 	}
 }
-void lcd_ui_add_widget(lcd_ui_context_t *ctx,
-		       const lcd_ui_widget_t *widget)
+
+void lcd_ui_fill_spans(lcd_ui_context_t *ctx,
+		       const lcd_ui_span_t *spans, uint16_t count,
+		       uint32_t colour)
 {
-	if (!ctx || !widget)
-		return;
+	lcd_ui_span_t batch[LCD_UI_SPAN_BATCH];
+	uint16_t batched = 0U;
+	lcd_ui_framebuffer_t fb;
+	uint8_t direct;
 
-	if (ctx->widget_count >= ctx->widget_capacity)
+	if (!ctx || !ctx->driver || !spans || (count == 0U))
 		return;
 
-	ctx->widgets[ctx->widget_count++] = (lcd_ui_widget_t *)widget;
+	/* Damage and stale syncing for the whole batch at once */
+	lcd_ui_rect_t bounds = {spans[0].x, spans[0].y, spans[0].length, 1U};
+	for (uint16_t i = 1U; i < count; ++i)
+	{
+		const lcd_ui_rect_t span = {spans[i].x, spans[i].y, spans[i].length, 1U};
+		if (!rect_is_empty(&span))
+			bounds = rect_is_empty(&bounds) ? span : rect_union(&bounds, &span);
+	}
+	begin_draw(ctx, &bounds, 0U);
 
-	if (widget->text_align > LCD_UI_ALIGN_RIGHT)
+	direct = !ctx->driver->fill_spans && ctx->driver->get_framebuffer &&
+		 ctx->driver->get_framebuffer(ctx->driver_instance, &fb);
+
+	for (uint16_t i = 0U; i < count; ++i)
 	{
-		ctx->widgets[ctx->widget_count]->text_align = LCD_UI_ALIGN_LEFT;
+		const lcd_ui_rect_t span = {spans[i].x, spans[i].y, spans[i].length, 1U};
+		lcd_ui_rect_t visible;
+
+		if (!rect_intersection(&span, &ctx->clip, &visible))
+			continue;
+
+		/* Rows stay rows at 0 and 180 degrees; otherwise they are columns */
+		visible = rect_to_native(ctx, &visible);
+
+		if (ctx->driver->fill_spans && (visible.height == 1U))
+		{
+			batch[batched].x = visible.x;
+			batch[batched].y = visible.y;
+			batch[batched].length = visible.width;
+			if (++batched == LCD_UI_SPAN_BATCH)
+			{
+				ctx->driver->fill_spans(ctx->driver_instance, batch, batched, colour);
+				batched = 0U;
+			}
+		}
+		else if (direct)
+		{
+			write_span(&fb, &visible, colour);
+		}
+		else
+		{
+			ctx->driver->draw_rect(ctx->driver_instance, visible.x, visible.y,
+					       visible.width, visible.height, colour);
+		}
 	}
+
+	if (batched != 0U)
+		ctx->driver->fill_spans(ctx->driver_instance, batch, batched, colour);
 }
 
 /**
- * @brief Internal utility to render a single widget.
- *        Used by both full render and selective redraw.
- * @note AI-aided via Supermaven Copilot — reviewed and adapted.
+ * @brief Blends @p count framebuffer pixels, @p step apart, towards
+ *        @p colour by their coverage.
  */
-static void draw_widget(const lcd_ui_context_t *context,
-			const lcd_ui_widget_t *widget)
+static void blend_pixels(const lcd_ui_framebuffer_t *fb, size_t offset, ptrdiff_t step,
+			 const uint8_t *coverage, uint16_t count, uint32_t colour)
 {
-	if (!context || !context->driver || !widget)
-		return;
+	if (fb->format == LCD_UI_PIXEL_RGB565)
+	{
+		uint16_t *dst = (uint16_t *)fb->pixels + offset;
 
-	switch (widget->type)
+		for (uint16_t i = 0U; i < count; ++i, dst += step)
+		{
+			if (coverage[i] != 0U)
+				*dst = argb_to_rgb565(blend_colours_linear(colour, rgb565_to_argb(*dst),
+									   coverage[i]));
+		}
+	}
+	else if (step == 1)
 	{
-	case LCD_UI_WIDGET_BUTTON:
+		blend_span_linear(colour, coverage, (uint32_t *)fb->pixels + offset, count);
+	}
+	else
 	{
-		context->driver->draw_rect(widget->x,
-					   widget->y,
-					   widget->width,
-					   widget->height,
-					   widget->background_color);
+		uint32_t *dst = (uint32_t *)fb->pixels + offset;
 
-		if (widget->label_text != NULL)
-		{
-			uint16_t font_w = context->driver->get_font_width();
-			uint16_t font_h = context->driver->get_font_height();
+		for (uint16_t i = 0U; i < count; ++i, dst += step)
+			*dst = blend_colours_linear(colour, *dst, coverage[i]);
+	}
+}
 
-			uint16_t text_len = (uint16_t)strlen(widget->label_text);
-			uint16_t text_width = text_len * font_w;
+/**
+ * @brief Without a way to read the panel back, fills the runs of pixels
+ *        that are at least half covered.
+ */
+static void threshold_span(lcd_ui_context_t *ctx, uint16_t x, uint16_t y,
+			   const uint8_t *coverage, uint16_t count, uint32_t colour)
+{
+	uint16_t i = 0U;
 
-			uint16_t text_x;
-			switch (widget->text_align)
-			{
-			case LCD_UI_ALIGN_CENTER:
-				text_x = widget->x + (widget->width - text_width) / 2U;
-				break;
-			case LCD_UI_ALIGN_RIGHT:
-				text_x = widget->x + widget->width - text_width;
-				break;
-			case LCD_UI_ALIGN_LEFT:
-			default:
-				text_x = widget->x;
-				break;
-			}
+	while (i < count)
+	{
+		uint16_t run = 0U;
 
-			uint16_t text_y = widget->y + (widget->height - font_h) / 2U;
+		while ((i < count) && (coverage[i] < 128U))
+			++i;
+		while ((i + run < count) && (coverage[i + run] >= 128U))
+			++run;
 
-			context->driver->draw_text(text_x,
-						   text_y,
-						   widget->label_text,
-						   widget->text_color,
-						   widget->background_color,
-						   LCD_UI_ALIGN_LEFT); // force manual alignment
+		if (run != 0U)
+		{
+			const lcd_ui_rect_t part = {(uint16_t)(x + i), y, run, 1U};
+			const lcd_ui_rect_t native = rect_to_native(ctx, &part);
+
+			ctx->driver->draw_rect(ctx->driver_instance, native.x, native.y,
+					       native.width, native.height, colour);
+			i = (uint16_t)(i + run);
 		}
-		break;
 	}
+}
 
-	case LCD_UI_WIDGET_LABEL:
-		if (widget->label_text != NULL)
+/**
+ * @brief Blends one visible run, already mapped to the panel. @p fb is
+ *        NULL when the panel cannot be read back.
+ */
+static void blend_run(lcd_ui_context_t *ctx, const lcd_ui_framebuffer_t *fb,
+		      const lcd_ui_rect_t *visible, const uint8_t *coverage, uint32_t colour)
+{
+	/* Panel order runs backwards at 180 and 270 degrees */
+	const lcd_ui_rect_t native = rect_to_native(ctx, visible);
+	const uint8_t reversed = (ctx->rotation == LCD_UI_ROTATION_180) ||
+				 (ctx->rotation == LCD_UI_ROTATION_270);
+	const uint8_t vertical = native.height != 1U;
+
+	if (ctx->driver->blend_span)
+	{
+		if (!reversed)
 		{
-			context->driver->draw_text(widget->x,
-						   widget->y,
-						   widget->label_text,
-						   widget->text_color,
-						   widget->background_color,
-						   widget->text_align);
+			ctx->driver->blend_span(ctx->driver_instance, native.x, native.y,
+						native.width, native.height, coverage, colour);
+			return;
 		}
-		break;
 
-	case LCD_UI_WIDGET_PROGRESS_BAR:
+		/* Logical chunks from the left land right to left on the panel */
+		uint8_t flipped[LCD_UI_SPAN_BATCH];
+		uint16_t end = (uint16_t)(vertical ? native.y + native.height : native.x + native.width);
+
+		for (uint16_t done = 0U; done < visible->width;)
+		{
+			const uint16_t left = (uint16_t)(visible->width - done);
+			const uint16_t n = (left < LCD_UI_SPAN_BATCH) ? left : (uint16_t)LCD_UI_SPAN_BATCH;
+
+			for (uint16_t i = 0U; i < n; ++i)
+				flipped[n - 1U - i] = coverage[done + i];
+
+			end = (uint16_t)(end - n);
+			if (vertical)
+				ctx->driver->blend_span(ctx->driver_instance, native.x, end, 1U, n,
+							flipped, colour);
+			else
+				ctx->driver->blend_span(ctx->driver_instance, end, native.y, n, 1U,
+							flipped, colour);
+			done = (uint16_t)(done + n);
+		}
+		return;
+	}
+
+	if (fb)
 	{
-		context->driver->draw_rect(widget->x,
-					   widget->y,
-					   widget->width,
-					   widget->height,
-					   widget->background_color);
+		const ptrdiff_t row = vertical ? (ptrdiff_t)fb->stride : 1;
+		size_t offset = (size_t)native.y * fb->stride + native.x;
 
-		uint16_t fill_width =
-		    (uint16_t)((widget->progress_percent * widget->width) / 100U);
+		if (reversed)
+			offset += (size_t)(visible->width - 1U) * (size_t)row;
 
-		context->driver->draw_rect(widget->x,
-					   widget->y,
-					   fill_width,
-					   widget->height,
-					   widget->text_color);
-		break;
+		blend_pixels(fb, offset, reversed ? -row : row, coverage, visible->width, colour);
+		return;
 	}
 
-	case LCD_UI_WIDGET_SLIDER:
+	threshold_span(ctx, visible->x, visible->y, coverage, visible->width, colour);
+}
+
+void lcd_ui_blend_spans(lcd_ui_context_t *ctx,
+			const lcd_ui_span_t *spans, uint16_t count,
+			const uint8_t *coverage, uint32_t colour)
+{
+	lcd_ui_framebuffer_t fb;
+	uint8_t readable;
+
+	if (!ctx || !ctx->driver || !spans || !coverage || (count == 0U))
+		return;
+
+	/* Damage and stale syncing for the whole batch at once */
+	lcd_ui_rect_t bounds = {spans[0].x, spans[0].y, spans[0].length, 1U};
+	for (uint16_t i = 1U; i < count; ++i)
 	{
-		const uint16_t knob_size = widget->height; // square knob
-		const uint16_t track_height = widget->height / 3U;
-		const uint16_t track_y = widget->y + (widget->height - track_height) / 2U;
+		const lcd_ui_rect_t span = {spans[i].x, spans[i].y, spans[i].length, 1U};
+		if (!rect_is_empty(&span))
+			bounds = rect_is_empty(&bounds) ? span : rect_union(&bounds, &span);
+	}
+	begin_draw(ctx, &bounds, 0U);
 
-		/* Clear the entire slider widget area first */
-		context->driver->draw_rect(widget->x,
-					   widget->y,
-					   widget->width,
-					   widget->height,
-					   widget->background_color);
+	readable = !ctx->driver->blend_span && ctx->driver->get_framebuffer &&
+		   ctx->driver->get_framebuffer(ctx->driver_instance, &fb);
 
-		/* Draw the slider track using text_color */
-		context->driver->draw_rect(widget->x,
-					   track_y,
-					   widget->width,
-					   track_height,
-					   widget->text_color); // Track color
+	for (uint16_t i = 0U; i < count; coverage += spans[i].length, ++i)
+	{
+		const lcd_ui_rect_t span = {spans[i].x, spans[i].y, spans[i].length, 1U};
+		lcd_ui_rect_t visible;
 
-		/* Compute knob position */
-		uint16_t usable_width = widget->width - knob_size;
-		uint16_t knob_x = widget->x + (widget->slider_value * usable_width) / 100U;
+		if (!rect_intersection(&span, &ctx->clip, &visible))
+			continue;
 
-		/* Clamp knob_x to ensure knob stays within widget bounds */
-		if (knob_x + knob_size > widget->x + widget->width)
+		blend_run(ctx, readable ? &fb : NULL, &visible, coverage + (visible.x - span.x), colour);
+	}
+}
+
+void lcd_ui_draw_text(lcd_ui_context_t *ctx,
+		      uint16_t x, uint16_t y, const char *text,
+		      uint32_t text_colour, uint32_t background_colour)
+{
+	if (!ctx || !ctx->driver || !text)
+		return;
+
+	const lcd_ui_rect_t box = {x, y,
+				   (uint16_t)(strlen(text) * ctx->driver->get_font_width(ctx->driver_instance)),
+				   ctx->driver->get_font_height(ctx->driver_instance)};
+
+	begin_draw(ctx, &box, 1U);
+	draw_text(ctx, x, y, text, text_colour, background_colour, LCD_UI_ALIGN_LEFT);
+}
+
+const lcd_ui_style_t *lcd_ui_get_widget_style(const lcd_ui_context_t *ctx,
+					      const lcd_ui_widget_t *widget)
+{
+	if (!ctx || !widget)
+		return NULL;
+
+	return widget_style(ctx, widget);
+}
+
+void lcd_ui_get_widget_colours(const lcd_ui_context_t *ctx,
+			       const lcd_ui_widget_t *widget,
+			       uint32_t *background, uint32_t *foreground)
+{
+	if (!ctx || !widget)
+		return;
+
+	const lcd_ui_style_t *style = widget_style(ctx, widget);
+
+	if (background)
+		*background = style ? style->background : widget->background_color;
+	if (foreground)
+		*foreground = style ? style->text : widget->text_color;
+}
+
+void lcd_ui_get_widget_bounds(const lcd_ui_context_t *ctx,
+			      const lcd_ui_widget_t *widget,
+			      lcd_ui_rect_t *bounds)
+{
+	uint8_t opaque;
+
+	if (!ctx || !ctx->driver || !widget || !bounds)
+		return;
+
+	widget_bounds(ctx, widget, bounds, &opaque);
+}
+
+void lcd_ui_build_style(lcd_ui_style_t *style,
+			uint32_t background, uint32_t text,
+			uint8_t margin)
+{
+	if (!style)
+		return;
+
+	/* Same shades as LCD_UI_PALETTE() */
+	style->background = background;
+	style->text = text;
+	style->shades.accent = lighten_colour(text, 40U);
+	style->shades.pressed = darken_colour(background, 20U);
+	style->shades.disabled = blend_colours(text, background, 128U);
+	style->shades.focused = lighten_colour(background, 20U);
+	style->margin = margin;
+}
+
+void lcd_ui_set_theme(lcd_ui_context_t *ctx,
+		      const lcd_ui_style_t *styles,
+		      uint8_t style_count)
+{
+	if (!ctx || !ctx->driver)
+		return;
+
+	ctx->styles = styles;
+	ctx->style_count = styles ? style_count : 0U;
+	++ctx->theme_version;
+
+	lcd_ui_render(ctx);
+}
+
+void lcd_ui_fill_gradient(lcd_ui_context_t *ctx,
+			  uint16_t x, uint16_t y,
+			  uint16_t w, uint16_t h,
+			  const lcd_ui_gradient_t *gradient)
+{
+	const lcd_ui_rect_t rect = {x, y, w, h};
+
+	if (!ctx || !ctx->driver || !gradient)
+		return;
+
+	begin_draw(ctx, &rect, 1U);
+	fill_gradient(ctx, &rect, &rect, gradient);
+}
+
+void lcd_ui_rotate_pixels(const uint32_t *src, uint16_t src_stride,
+			  uint16_t width, uint16_t height,
+			  uint32_t *dst, uint16_t dst_stride,
+			  lcd_ui_rotation_t rotation)
+{
+	if (!src || !dst || (width == 0U) || (height == 0U))
+		return;
+
+	switch (rotation)
+	{
+	case LCD_UI_ROTATION_0:
+		for (uint16_t y = 0U; y < height; ++y)
 		{
-			knob_x = widget->x + widget->width - knob_size;
+			memcpy(dst + (size_t)y * dst_stride, src + (size_t)y * src_stride,
+			       (size_t)width * sizeof(uint32_t));
+		}
+		break;
+
+	case LCD_UI_ROTATION_180:
+		/* Rows stay rows, so no blocking is needed */
+		for (uint16_t y = 0U; y < height; ++y)
+		{
+			const uint32_t *in = src + (size_t)y * src_stride;
+			uint32_t *out = dst + (size_t)(height - 1U - y) * dst_stride + (width - 1U);
+
+			for (uint16_t x = 0U; x < width; ++x)
+			{
+				*out-- = in[x];
+			}
 		}
+		break;
 
-		/* Compute knob color (lighter version of text_color) */
-		uint32_t knob_color = lighten_colour(widget->text_color, 40U);
+	case LCD_UI_ROTATION_90:
+	case LCD_UI_ROTATION_270:
+		for (uint16_t by = 0U; by < height; by += LCD_UI_ROTATE_TILE)
+		{
+			const uint16_t y_end = ((uint16_t)(height - by) > LCD_UI_ROTATE_TILE) ? (by + LCD_UI_ROTATE_TILE) : height;
 
-		/* Draw the knob (square) */
-		context->driver->draw_rect(knob_x,
-					   widget->y,
-					   knob_size,
-					   knob_size,
-					   knob_color); // Knob
+			for (uint16_t bx = 0U; bx < width; bx += LCD_UI_ROTATE_TILE)
+			{
+				const uint16_t x_end = ((uint16_t)(width - bx) > LCD_UI_ROTATE_TILE) ? (bx + LCD_UI_ROTATE_TILE) : width;
+
+				for (uint16_t y = by; y < y_end; ++y)
+				{
+					const uint32_t *in = src + (size_t)y * src_stride;
 
+					for (uint16_t x = bx; x < x_end; ++x)
+					{
+						/* 90: (x, y) -> (h-1-y, x); 270: (x, y) -> (y, w-1-x) */
+						const size_t index = (rotation == LCD_UI_ROTATION_90)
+									 ? (size_t)x * dst_stride + (height - 1U - y)
+									 : (size_t)(width - 1U - x) * dst_stride + y;
+						dst[index] = in[x];
+					}
+				}
+			}
+		}
 		break;
-	}
 
 	default:
 		break;
 	}
 }
 
-void lcd_ui_render(const lcd_ui_context_t *ctx)
+/**
+ * @brief First quarter of a sine wave, Q14, one entry per 1/1024 turn.
+ */
+static const int16_t quarter_sine[LCD_UI_ANGLE_TURN / 4U + 1U] = {
+	0, 101, 201, 302, 402, 503, 603, 704,
+	804, 904, 1005, 1105, 1205, 1306, 1406, 1506,
+	1606, 1706, 1806, 1906, 2006, 2105, 2205, 2305,
+	2404, 2503, 2603, 2702, 2801, 2900, 2999, 3098,
+	3196, 3295, 3393, 3492, 3590, 3688, 3786, 3883,
+	3981, 4078, 4176, 4273, 4370, 4467, 4563, 4660,
+	4756, 4852, 4948, 5044, 5139, 5235, 5330, 5425,
+	5520, 5614, 5708, 5803, 5897, 5990, 6084, 6177,
+	6270, 6363, 6455, 6547, 6639, 6731, 6823, 6914,
+	7005, 7096, 7186, 7276, 7366, 7456, 7545, 7635,
+	7723, 7812, 7900, 7988, 8076, 8163, 8250, 8337,
+	8423, 8509, 8595, 8680, 8765, 8850, 8935, 9019,
+	9102, 9186, 9269, 9352, 9434, 9516, 9598, 9679,
+	9760, 9841, 9921, 10001, 10080, 10159, 10238, 10316,
+	10394, 10471, 10549, 10625, 10702, 10778, 10853, 10928,
+	11003, 11077, 11151, 11224, 11297, 11370, 11442, 11514,
+	11585, 11656, 11727, 11797, 11866, 11935, 12004, 12072,
+	12140, 12207, 12274, 12340, 12406, 12472, 12537, 12601,
+	12665, 12729, 12792, 12854, 12916, 12978, 13039, 13100,
+	13160, 13219, 13279, 13337, 13395, 13453, 13510, 13567,
+	13623, 13678, 13733, 13788, 13842, 13896, 13949, 14001,
+	14053, 14104, 14155, 14206, 14256, 14305, 14354, 14402,
+	14449, 14497, 14543, 14589, 14635, 14680, 14724, 14768,
+	14811, 14854, 14896, 14937, 14978, 15019, 15059, 15098,
+	15137, 15175, 15213, 15250, 15286, 15322, 15357, 15392,
+	15426, 15460, 15493, 15525, 15557, 15588, 15619, 15649,
+	15679, 15707, 15736, 15763, 15791, 15817, 15843, 15868,
+	15893, 15917, 15941, 15964, 15986, 16008, 16029, 16049,
+	16069, 16088, 16107, 16125, 16143, 16160, 16176, 16192,
+	16207, 16221, 16235, 16248, 16261, 16273, 16284, 16295,
+	16305, 16315, 16324, 16332, 16340, 16347, 16353, 16359,
+	16364, 16369, 16373, 16376, 16379, 16381, 16383, 16384,
+	16384,
+};
+
+int16_t lcd_ui_sin(uint16_t angle)
 {
-	if (!ctx || !ctx->driver)
-		return;
+	const uint16_t quarter = LCD_UI_ANGLE_TURN / 4U;
+	const uint16_t a = angle % LCD_UI_ANGLE_TURN;
+	const uint16_t i = a % quarter;
 
-	for (uint8_t i = 0; i < ctx->widget_count; ++i)
+	switch (a / quarter)
 	{
-		draw_widget(ctx, ctx->widgets[i]);
+	case 0U:
+		return quarter_sine[i];
+	case 1U:
+		return quarter_sine[quarter - i];
+	case 2U:
+		return (int16_t)-quarter_sine[i];
+	default:
+		return (int16_t)-quarter_sine[quarter - i];
 	}
 }
 
-void lcd_ui_redraw_widget(const lcd_ui_context_t *context,
-			  const lcd_ui_widget_t *widget)
+int16_t lcd_ui_cos(uint16_t angle)
 {
-	draw_widget(context, widget);
+	return lcd_ui_sin((uint16_t)(angle + LCD_UI_ANGLE_TURN / 4U));
+}
+
+/**
+ * @brief Whether a touch at (x, y) lands on @p w, with a little slack
+ *        around the edges for easier hits.
+ */
+static uint8_t widget_hit(const lcd_ui_widget_t *w, uint16_t x, uint16_t y)
+{
+	uint16_t margin = 0U;
+
+	switch (w->type)
+	{
+	case LCD_UI_WIDGET_BUTTON:
+		margin = 6U; // Slight padding for easier touch
+		break;
+
+	case LCD_UI_WIDGET_SLIDER:
+		margin = w->height / 5U;
+		break;
+
+	default:
+		margin = 2U;
+		break;
+	}
+
+	uint16_t x0 = (w->x > margin) ? (w->x - margin) : 0U;
+	uint16_t y0 = (w->y > margin) ? (w->y - margin) : 0U;
+	uint16_t x1 = w->x + w->width + margin;
+	uint16_t y1 = w->y + w->height + margin;
+
+	return (x >= x0) && (x < x1) && (y >= y0) && (y < y1);
 }
 
 static void default_slider_touch_handler(lcd_ui_context_t *ctx,
@@ -276,6 +2301,9 @@ void lcd_ui_handle_touch(lcd_ui_context_t *ctx,
 	if (!ctx)
 		return;
 
+	/* Touch panels report in panel orientation */
+	point_from_native(ctx, &x, &y);
+
 	if (is_pressed)
 	{
 		if (!ctx->touch_active)
@@ -284,38 +2312,36 @@ void lcd_ui_handle_touch(lcd_ui_context_t *ctx,
 			ctx->touch_active = 1;
 			ctx->active_widget = NULL;
 
+			if (ctx->driver && ctx->driver->get_time_us)
+				ctx->press_time_us = ctx->driver->get_time_us(ctx->driver_instance);
+
 			for (uint8_t i = 0; i < ctx->widget_count; ++i)
 			{
-				lcd_ui_widget_t *w = ctx->widgets[i];
-
-				uint16_t margin = 0U;
-
-				switch (w->type)
+				if (widget_hit(ctx->widgets[i], x, y))
 				{
-				case LCD_UI_WIDGET_BUTTON:
-					margin = 6U; // Slight padding for easier touch
-					break;
-
-				case LCD_UI_WIDGET_SLIDER:
-					margin = w->height / 5U;
-					break;
-
-				default:
-					margin = 2U;
+					ctx->active_widget = ctx->widgets[i];
 					break;
 				}
+			}
 
-				uint16_t x0 = (w->x > margin) ? (w->x - margin) : 0U;
-				uint16_t y0 = (w->y > margin) ? (w->y - margin) : 0U;
-				uint16_t x1 = w->x + w->width + margin;
-				uint16_t y1 = w->y + w->height + margin;
+			if (ctx->active_widget && ctx->active_widget->type == LCD_UI_WIDGET_LIST)
+				lcd_ui_list_touch(ctx, ctx->active_widget, x, y, 1U);
+			else if (ctx->active_widget && ctx->active_widget->type == LCD_UI_WIDGET_TABLE)
+				lcd_ui_table_touch(ctx, ctx->active_widget, x, y);
+			else if (ctx->active_widget && ctx->active_widget->type == LCD_UI_WIDGET_KEYBOARD)
+				lcd_ui_keyboard_touch(ctx, ctx->active_widget, x, y, 1U);
 
-				if ((x >= x0) && (x < x1) &&
-				    (y >= y0) && (y < y1))
-				{
-					ctx->active_widget = w;
-					break;
-				}
+			/* Show the button pressed straight away */
+			if (ctx->driver && ctx->active_widget &&
+			    ctx->active_widget->type == LCD_UI_WIDGET_BUTTON)
+			{
+				ctx->pressed_widget = ctx->active_widget;
+				lcd_ui_redraw_widget(ctx, ctx->active_widget);
+
+				if (ctx->driver->flip)
+					ctx->feedback_pending = 1U;
+				else
+					record_feedback(ctx);
 			}
 		}
 
@@ -335,26 +2361,89 @@ void lcd_ui_handle_touch(lcd_ui_context_t *ctx,
 								     ctx->active_widget->user_data);
 				}
 			}
+			else if (ctx->active_widget->type == LCD_UI_WIDGET_LIST)
+			{
+				lcd_ui_list_touch(ctx, ctx->active_widget, x, y, 2U);
+			}
+			else if (ctx->active_widget->type == LCD_UI_WIDGET_KEYBOARD)
+			{
+				lcd_ui_keyboard_touch(ctx, ctx->active_widget, x, y, 2U);
+			}
+			else if (ctx->active_widget->type == LCD_UI_WIDGET_BUTTON &&
+				 !widget_hit(ctx->active_widget, x, y))
+			{
+				/* Slid off the button: cancel without firing */
+				lcd_ui_widget_t *button = ctx->active_widget;
+
+				ctx->active_widget = NULL;
+				ctx->pressed_widget = NULL;
+				lcd_ui_redraw_widget(ctx, button);
+			}
 		}
 	}
 	else
 	{
-		/* On release: trigger button if it was the active widget */
+		lcd_ui_widget_t *button = NULL;
+		lcd_ui_widget_t *list = NULL;
+		lcd_ui_widget_t *keyboard = NULL;
+
 		if (ctx->active_widget &&
-		    ctx->active_widget->type == LCD_UI_WIDGET_BUTTON &&
-		    ctx->active_widget->on_touch)
+		    ctx->active_widget->type == LCD_UI_WIDGET_BUTTON)
+		{
+			button = ctx->active_widget;
+		}
+		else if (ctx->active_widget &&
+			 ctx->active_widget->type == LCD_UI_WIDGET_LIST)
 		{
-			ctx->active_widget->on_touch(ctx,
-						     ctx->active_widget,
-						     x, y,
-						     ctx->active_widget->user_data);
+			list = ctx->active_widget;
+		}
+		else if (ctx->active_widget &&
+			 ctx->active_widget->type == LCD_UI_WIDGET_KEYBOARD)
+		{
+			keyboard = ctx->active_widget;
 		}
 
 		ctx->touch_active = 0;
 		ctx->active_widget = NULL;
+
+		/* A list tap selects its row and fires on_touch */
+		if (list)
+		{
+			lcd_ui_list_touch(ctx, list, x, y, 0U);
+		}
+
+		/* A key is typed when the finger lifts off it */
+		if (keyboard)
+		{
+			lcd_ui_keyboard_touch(ctx, keyboard, x, y, 0U);
+		}
+
+		/* On release: restore the button, then trigger it */
+		if (button)
+		{
+			ctx->pressed_widget = NULL;
+			lcd_ui_redraw_widget(ctx, button);
+
+			if (button->on_touch)
+			{
+				button->on_touch(ctx, button, x, y, button->user_data);
+			}
+		}
 	}
 }
 
+void lcd_ui_get_feedback_latency(const lcd_ui_context_t *ctx,
+				 uint32_t *last_us, uint32_t *worst_us)
+{
+	if (!ctx)
+		return;
+
+	if (last_us)
+		*last_us = ctx->feedback_latency_us;
+	if (worst_us)
+		*worst_us = ctx->feedback_latency_max_us;
+}
+
 /**
  * @brief Get the screen width in pixels.
  * @param ctx Pointer to initialized lcd_ui_context_t
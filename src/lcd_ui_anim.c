@@ -0,0 +1,500 @@
+/**
+ * @file        lcd_ui_anim.c
+ * @brief       Tween scheduler animating widget properties frame by frame.
+ *
+ * @author      Ryan Hicks <c3361231@uon.edu.au>
+ *              School of Engineering (Electrical and Computer Engineering)
+ *              University of Newcastle
+ *
+ * @date        2025-04-11
+ * @version     1.0.0
+ *
+ * @copyright   Copyright (c) 2025 Ryan
+ * @license     SPDX-License-Identifier: MIT
+ *
+ * @note        Redistribution and use permitted with attribution.
+ */
+
+#include "lcd_ui_anim.h"
+#include "lcd_ui_gamma.h"
+
+/* Tween progress and eased progress are 16.16 fixed point */
+#define PROGRESS_ONE 65536U
+
+uint32_t lcd_ui_ease(lcd_ui_easing_t easing, uint32_t progress)
+{
+	const uint64_t p = progress;
+
+	switch (easing)
+	{
+	case LCD_UI_EASE_IN:
+		return (uint32_t)((p * p) >> 16);
+	case LCD_UI_EASE_OUT:
+	{
+		const uint64_t remaining = PROGRESS_ONE - p;
+		return PROGRESS_ONE - (uint32_t)((remaining * remaining) >> 16);
+	}
+	case LCD_UI_EASE_IN_OUT:
+	{
+		/* 3p^2 - 2p^3 */
+		const uint64_t squared = (p * p) >> 16;
+		return (uint32_t)(3U * squared - ((2U * squared * p) >> 16));
+	}
+	case LCD_UI_EASE_LINEAR:
+	default:
+		return progress;
+	}
+}
+
+static uint8_t is_colour(uint8_t property)
+{
+	return (property == LCD_UI_TWEEN_BACKGROUND) || (property == LCD_UI_TWEEN_TEXT);
+}
+
+static int32_t get_property(const lcd_ui_widget_t *widget, uint8_t property)
+{
+	switch (property)
+	{
+	case LCD_UI_TWEEN_X:
+		return widget->x;
+	case LCD_UI_TWEEN_Y:
+		return widget->y;
+	case LCD_UI_TWEEN_BACKGROUND:
+		return (int32_t)widget->background_color;
+	case LCD_UI_TWEEN_TEXT:
+		return (int32_t)widget->text_color;
+	case LCD_UI_TWEEN_VALUE:
+		return (int32_t)widget->slider_value;
+	case LCD_UI_TWEEN_PROGRESS:
+		return widget->progress_percent;
+	default:
+		return 0;
+	}
+}
+
+/**
+ * @return Non-zero if the property changed.
+ */
+static uint8_t set_property(lcd_ui_widget_t *widget, uint8_t property, int32_t value)
+{
+	if (get_property(widget, property) == value)
+		return 0U;
+
+	switch (property)
+	{
+	case LCD_UI_TWEEN_X:
+		widget->x = (uint16_t)value;
+		break;
+	case LCD_UI_TWEEN_Y:
+		widget->y = (uint16_t)value;
+		break;
+	case LCD_UI_TWEEN_BACKGROUND:
+		widget->background_color = (uint32_t)value;
+		break;
+	case LCD_UI_TWEEN_TEXT:
+		widget->text_color = (uint32_t)value;
+		break;
+	case LCD_UI_TWEEN_VALUE:
+		widget->slider_value = (uint32_t)value;
+		break;
+	case LCD_UI_TWEEN_PROGRESS:
+		widget->progress_percent = (uint8_t)value;
+		break;
+	default:
+		return 0U;
+	}
+
+	return 1U;
+}
+
+/**
+ * @brief Value of a tween @p elapsed_us into its run.
+ */
+static int32_t tween_value(const lcd_ui_tween_t *tween, uint32_t elapsed_us)
+{
+	uint32_t progress = PROGRESS_ONE;
+
+	if (elapsed_us < tween->duration_us)
+		progress = (uint32_t)(((uint64_t)elapsed_us << 16) / tween->duration_us);
+
+	const uint32_t eased = lcd_ui_ease((lcd_ui_easing_t)tween->easing, progress);
+
+	if (is_colour(tween->property))
+	{
+		const uint8_t alpha = (uint8_t)((eased * 255U + PROGRESS_ONE / 2U) >> 16);
+		return (int32_t)blend_colours_linear((uint32_t)tween->to, (uint32_t)tween->from, alpha);
+	}
+
+	return tween->from + (int32_t)(((int64_t)tween->to - tween->from) * eased / (int64_t)PROGRESS_ONE);
+}
+
+/**
+ * @brief Moves a tween on to frame time @p frame_us and applies its
+ *        value, freeing the slot once it has finished.
+ * @return Non-zero if a widget property changed.
+ */
+static uint8_t step(lcd_ui_animator_t *anim, lcd_ui_tween_t *tween, uint32_t frame_us)
+{
+	lcd_ui_widget_t *widget = tween->widget;
+	uint8_t changed = 0U;
+	uint8_t finished = 0U;
+
+	/* The first frame already shows one step of movement */
+	if (!tween->started)
+	{
+		tween->start_us = frame_us - anim->frame_us;
+		tween->started = 1U;
+	}
+
+	uint32_t elapsed = frame_us - tween->start_us;
+
+	if (elapsed >= tween->duration_us)
+	{
+		if (tween->loop && (tween->duration_us != 0U))
+		{
+			elapsed %= tween->duration_us;
+			tween->start_us = frame_us - elapsed;
+		}
+		else
+		{
+			elapsed = tween->duration_us;
+			finished = 1U;
+		}
+	}
+
+	const int32_t value = tween_value(tween, elapsed);
+
+	if (tween->property == LCD_UI_TWEEN_CUSTOM)
+	{
+		if (tween->apply)
+			tween->apply(anim->ctx, widget, value, tween->user_data);
+	}
+	else
+	{
+		changed = set_property(widget, tween->property, value);
+	}
+
+	if (finished)
+		tween->widget = NULL;
+
+	return changed;
+}
+
+static uint32_t area_of(const lcd_ui_rect_t *rect)
+{
+	return (uint32_t)rect->width * rect->height;
+}
+
+static lcd_ui_rect_t bounding(const lcd_ui_rect_t *a, const lcd_ui_rect_t *b)
+{
+	const int32_t left = (a->x < b->x) ? a->x : b->x;
+	const int32_t top = (a->y < b->y) ? a->y : b->y;
+	const int32_t right = ((a->x + a->width) > (b->x + b->width)) ? (a->x + a->width) : (b->x + b->width);
+	const int32_t bottom = ((a->y + a->height) > (b->y + b->height)) ? (a->y + a->height) : (b->y + b->height);
+	lcd_ui_rect_t rect;
+
+	rect.x = (uint16_t)left;
+	rect.y = (uint16_t)top;
+	rect.width = (uint16_t)(right - left);
+	rect.height = (uint16_t)(bottom - top);
+	return rect;
+}
+
+/**
+ * @brief Adds a rect to the frame's damage. Rects are merged when their
+ *        bounding box is no bigger than the two apart. The box can take
+ *        in pixels neither rect touched, so the damage is conservative
+ *        (may over-cover); a full list takes the merge that grows least.
+ *        @p settled marks a widget's new area.
+ */
+static void add_damage(lcd_ui_animator_t *anim, lcd_ui_rect_t rect, uint8_t settled)
+{
+	uint8_t i = 0U;
+
+	if ((rect.width == 0U) || (rect.height == 0U))
+		return;
+
+	while (i < anim->damage_count)
+	{
+		const lcd_ui_rect_t merged = bounding(&anim->damage[i], &rect);
+
+		if (area_of(&merged) <= area_of(&anim->damage[i]) + area_of(&rect))
+		{
+			rect = merged;
+			settled |= anim->damage_settled[i];
+			--anim->damage_count;
+			anim->damage[i] = anim->damage[anim->damage_count];
+			anim->damage_settled[i] = anim->damage_settled[anim->damage_count];
+			i = 0U; /* rect grew, rescan */
+		}
+		else
+		{
+			++i;
+		}
+	}
+
+	if (anim->damage_count < LCD_UI_MAX_DAMAGE_RECTS)
+	{
+		anim->damage_settled[anim->damage_count] = settled;
+		anim->damage[anim->damage_count++] = rect;
+		return;
+	}
+
+	uint8_t best = 0U;
+	uint32_t best_growth = UINT32_MAX;
+
+	for (i = 0U; i < anim->damage_count; ++i)
+	{
+		const lcd_ui_rect_t merged = bounding(&anim->damage[i], &rect);
+		const uint32_t growth = area_of(&merged) - area_of(&anim->damage[i]);
+
+		if (growth < best_growth)
+		{
+			best_growth = growth;
+			best = i;
+		}
+	}
+
+	anim->damage[best] = bounding(&anim->damage[best], &rect);
+	anim->damage_settled[best] |= settled;
+}
+
+/**
+ * @brief Adds the part of @p before that @p after no longer covers, as
+ *        up to four bands around their overlap.
+ */
+static void add_uncovered(lcd_ui_animator_t *anim,
+			  const lcd_ui_rect_t *before, const lcd_ui_rect_t *after)
+{
+	const int32_t left = before->x;
+	const int32_t top = before->y;
+	const int32_t right = before->x + before->width;
+	const int32_t bottom = before->y + before->height;
+	const int32_t inner_left = (after->x > left) ? after->x : left;
+	const int32_t inner_top = (after->y > top) ? after->y : top;
+	const int32_t inner_right = ((after->x + after->width) < right) ? (after->x + after->width) : right;
+	const int32_t inner_bottom = ((after->y + after->height) < bottom) ? (after->y + after->height) : bottom;
+
+	if ((inner_left >= inner_right) || (inner_top >= inner_bottom))
+	{
+		add_damage(anim, *before, 0U);
+		return;
+	}
+
+	const lcd_ui_rect_t bands[4] = {
+	    {(uint16_t)left, (uint16_t)top, (uint16_t)(right - left), (uint16_t)(inner_top - top)},
+	    {(uint16_t)left, (uint16_t)inner_bottom, (uint16_t)(right - left), (uint16_t)(bottom - inner_bottom)},
+	    {(uint16_t)left, (uint16_t)inner_top, (uint16_t)(inner_left - left), (uint16_t)(inner_bottom - inner_top)},
+	    {(uint16_t)inner_right, (uint16_t)inner_top, (uint16_t)(right - inner_right), (uint16_t)(inner_bottom - inner_top)},
+	};
+
+	for (uint8_t i = 0U; i < 4U; ++i)
+		add_damage(anim, bands[i], 0U);
+}
+
+void lcd_ui_animator_init(lcd_ui_animator_t *anim, lcd_ui_context_t *ctx,
+			  lcd_ui_tween_t *tweens, uint8_t capacity,
+			  uint32_t frame_us)
+{
+	if (!anim)
+		return;
+
+	anim->ctx = ctx;
+	anim->tweens = tweens;
+	anim->capacity = tweens ? capacity : 0U;
+	anim->frame_us = frame_us;
+	anim->next_frame_us = 0U;
+	anim->running = 0U;
+	anim->damage_count = 0U;
+	anim->frames = 0U;
+
+	for (uint8_t i = 0U; i < anim->capacity; ++i)
+		tweens[i].widget = NULL;
+}
+
+/**
+ * @brief The slot already driving @p property of @p widget, or else a
+ *        free one.
+ */
+static lcd_ui_tween_t *claim(lcd_ui_animator_t *anim, lcd_ui_widget_t *widget,
+			     lcd_ui_tween_property_t property)
+{
+	lcd_ui_tween_t *free_slot = NULL;
+
+	for (uint8_t i = 0U; i < anim->capacity; ++i)
+	{
+		lcd_ui_tween_t *tween = &anim->tweens[i];
+
+		if ((tween->widget == widget) && (tween->property == (uint8_t)property))
+			return tween;
+		if (!tween->widget && !free_slot)
+			free_slot = tween;
+	}
+
+	return free_slot;
+}
+
+static void start(lcd_ui_tween_t *tween, lcd_ui_widget_t *widget,
+		  lcd_ui_tween_property_t property, int32_t from, int32_t to,
+		  uint32_t duration_us, lcd_ui_easing_t easing)
+{
+	tween->widget = widget;
+	tween->from = from;
+	tween->to = to;
+	tween->start_us = 0U;
+	tween->duration_us = duration_us;
+	tween->apply = NULL;
+	tween->user_data = NULL;
+	tween->property = (uint8_t)property;
+	tween->easing = (uint8_t)easing;
+	tween->loop = 0U;
+	tween->started = 0U;
+}
+
+lcd_ui_tween_t *lcd_ui_animate(lcd_ui_animator_t *anim, lcd_ui_widget_t *widget,
+			       lcd_ui_tween_property_t property, int32_t to,
+			       uint32_t duration_us, lcd_ui_easing_t easing)
+{
+	if (!anim || !widget || (property == LCD_UI_TWEEN_CUSTOM))
+		return NULL;
+
+	lcd_ui_tween_t *tween = claim(anim, widget, property);
+
+	if (tween)
+		start(tween, widget, property, get_property(widget, (uint8_t)property), to,
+		      duration_us, easing);
+	return tween;
+}
+
+lcd_ui_tween_t *lcd_ui_animate_custom(lcd_ui_animator_t *anim, lcd_ui_widget_t *widget,
+				      int32_t from, int32_t to,
+				      uint32_t duration_us, lcd_ui_easing_t easing,
+				      lcd_ui_tween_apply_t apply, void *user_data)
+{
+	if (!anim || !widget || !apply)
+		return NULL;
+
+	lcd_ui_tween_t *tween = claim(anim, widget, LCD_UI_TWEEN_CUSTOM);
+
+	if (tween)
+	{
+		start(tween, widget, LCD_UI_TWEEN_CUSTOM, from, to, duration_us, easing);
+		tween->apply = apply;
+		tween->user_data = user_data;
+	}
+	return tween;
+}
+
+void lcd_ui_animation_stop(lcd_ui_animator_t *anim, const lcd_ui_widget_t *widget)
+{
+	if (!anim)
+		return;
+
+	for (uint8_t i = 0U; i < anim->capacity; ++i)
+	{
+		if (anim->tweens[i].widget == widget)
+			anim->tweens[i].widget = NULL;
+	}
+}
+
+uint8_t lcd_ui_animating(const lcd_ui_animator_t *anim, const lcd_ui_widget_t *widget)
+{
+	if (!anim)
+		return 0U;
+
+	for (uint8_t i = 0U; i < anim->capacity; ++i)
+	{
+		if (anim->tweens[i].widget && (!widget || (anim->tweens[i].widget == widget)))
+			return 1U;
+	}
+
+	return 0U;
+}
+
+uint8_t lcd_ui_tick(lcd_ui_animator_t *anim, uint32_t now_us)
+{
+	if (!anim || !anim->ctx)
+		return 0U;
+
+	if (!lcd_ui_animating(anim, NULL))
+	{
+		anim->running = 0U;
+		return 0U;
+	}
+
+	if (!anim->running)
+	{
+		anim->next_frame_us = now_us;
+		anim->running = 1U;
+	}
+
+	if ((int32_t)(now_us - anim->next_frame_us) < 0)
+		return 0U;
+
+	/* Snap to the grid; frames missed by a late tick are skipped, not queued */
+	uint32_t frame = now_us;
+
+	if (anim->frame_us != 0U)
+		frame = now_us - (now_us - anim->next_frame_us) % anim->frame_us;
+	anim->next_frame_us = frame + anim->frame_us;
+	anim->damage_count = 0U;
+
+	/* Widget by widget, so moving in x and y at once is one damage pair */
+	for (uint8_t i = 0U; i < anim->capacity; ++i)
+	{
+		lcd_ui_widget_t *widget = anim->tweens[i].widget;
+		uint8_t seen = 0U;
+		uint8_t changed = 0U;
+		lcd_ui_rect_t before;
+		lcd_ui_rect_t after;
+
+		if (!widget || (anim->tweens[i].property == LCD_UI_TWEEN_CUSTOM))
+			continue;
+
+		for (uint8_t j = 0U; (j < i) && !seen; ++j)
+			seen = (anim->tweens[j].widget == widget) &&
+			       (anim->tweens[j].property != LCD_UI_TWEEN_CUSTOM);
+		if (seen)
+			continue;
+
+		lcd_ui_get_widget_bounds(anim->ctx, widget, &before);
+
+		for (uint8_t k = i; k < anim->capacity; ++k)
+		{
+			if ((anim->tweens[k].widget == widget) &&
+			    (anim->tweens[k].property != LCD_UI_TWEEN_CUSTOM))
+				changed |= step(anim, &anim->tweens[k], frame);
+		}
+
+		if (!changed)
+			continue;
+
+		lcd_ui_get_widget_bounds(anim->ctx, widget, &after);
+		add_damage(anim, after, 1U);
+		add_uncovered(anim, &before, &after);
+	}
+
+	/*
+	 * Text is drawn whole, so repainting what a widget uncovered can
+	 * spill lower widgets' labels a few pixels into its new area. The
+	 * new areas go last to paint over it.
+	 */
+	for (uint8_t pass = 0U; pass < 2U; ++pass)
+	{
+		for (uint8_t d = 0U; d < anim->damage_count; ++d)
+		{
+			if (anim->damage_settled[d] == pass)
+				lcd_ui_repaint_area(anim->ctx, &anim->damage[d]);
+		}
+	}
+
+	/* Custom tweens draw for themselves, on top of the repaint */
+	for (uint8_t i = 0U; i < anim->capacity; ++i)
+	{
+		if (anim->tweens[i].widget && (anim->tweens[i].property == LCD_UI_TWEEN_CUSTOM))
+			step(anim, &anim->tweens[i], frame);
+	}
+
+	++anim->frames;
+	return 1U;
+}
@@ -15,27 +15,134 @@
  * @note        Redistribution and use permitted with attribution.
  */
 
-#include "lcd_ui.h"
+#include "lcd_ui_driver.h"
 #include "stm32h747i_discovery_lcd.h" // STM32 board specific LCD header
 #include "stm32_lcd.h"                // STM32 LCD driver header
 
-static void driver_init(void)
+/**
+ * @brief DMA2D memory-to-memory copy of an ARGB8888 block.
+ */
+static void dma2d_copy(uint32_t source, uint32_t destination,
+		       uint16_t w, uint16_t h, uint32_t pitch)
 {
-	(void)BSP_LCD_Init(0, LCD_ORIENTATION_LANDSCAPE);
+	hlcd_dma2d.Init.Mode = DMA2D_M2M;
+	hlcd_dma2d.Init.ColorMode = DMA2D_OUTPUT_ARGB8888;
+	hlcd_dma2d.Init.OutputOffset = pitch - w;
+	hlcd_dma2d.LayerCfg[1].InputOffset = pitch - w;
+	hlcd_dma2d.LayerCfg[1].InputColorMode = DMA2D_INPUT_ARGB8888;
+	hlcd_dma2d.LayerCfg[1].AlphaMode = DMA2D_NO_MODIF_ALPHA;
+	hlcd_dma2d.LayerCfg[1].InputAlpha = 0xFFU;
+
+	if ((HAL_DMA2D_Init(&hlcd_dma2d) == HAL_OK) &&
+	    (HAL_DMA2D_ConfigLayer(&hlcd_dma2d, 1U) == HAL_OK) &&
+	    (HAL_DMA2D_Start(&hlcd_dma2d, source, destination, w, h) == HAL_OK))
+	{
+		(void)HAL_DMA2D_PollForTransfer(&hlcd_dma2d, 25U);
+	}
+}
+
+/* Back frame for double buffering, right after the first in SDRAM */
+#ifndef LCD_UI_BSP_BACK_BUFFER_ADDRESS
+#define LCD_UI_BSP_BACK_BUFFER_ADDRESS (LCD_LAYER_0_ADDRESS + (800U * 480U * 4U))
+#endif
+
+lcd_ui_bsp_instance_t lcd_ui_bsp_instance = {
+    .lcd_instance = 0U,
+    .layer = 0U,
+    .front_buffer_address = LCD_LAYER_0_ADDRESS,
+    .back_buffer_address = LCD_UI_BSP_BACK_BUFFER_ADDRESS,
+};
+
+/**
+ * @brief Points the shared UTIL_LCD state at this instance's layer. The
+ *        state stays global, so instances may interleave on one task but
+ *        not run concurrently.
+ */
+static lcd_ui_bsp_instance_t *select_instance(void *instance)
+{
+	lcd_ui_bsp_instance_t *bsp = (lcd_ui_bsp_instance_t *)instance;
+	UTIL_LCD_SetLayer(bsp->layer);
+	return bsp;
+}
+
+static uint32_t screen_pitch(const lcd_ui_bsp_instance_t *bsp)
+{
+	uint32_t pitch = 0U;
+	(void)BSP_LCD_GetXSize(bsp->lcd_instance, &pitch);
+	return pitch;
+}
+
+/*
+ * Define LCD_UI_BSP_DOUBLE_BUFFER to render into a second SDRAM frame and
+ * flip the LTDC layer address at vertical blank. The layer is ARGB8888.
+ */
+#ifdef LCD_UI_BSP_DOUBLE_BUFFER
+
+static void driver_flip(void *instance)
+{
+	lcd_ui_bsp_instance_t *bsp = (lcd_ui_bsp_instance_t *)instance;
+	uint32_t shown = bsp->back_buffer_address;
+
+	bsp->back_buffer_address = bsp->front_buffer_address;
+	bsp->front_buffer_address = shown;
+
+	(void)HAL_LTDC_SetAddress_NoReload(&hlcd_ltdc, bsp->front_buffer_address, bsp->layer);
+	(void)HAL_LTDC_Reload(&hlcd_ltdc, LTDC_RELOAD_VERTICAL_BLANKING);
+
+	/* The shadow registers latch at the next blank; wait for it */
+	while ((hlcd_ltdc.Instance->SRCR & LTDC_SRCR_VBR) != 0U)
+	{
+	}
+
+	/* BSP drawing targets the handle's address, not the live register */
+	hlcd_ltdc.LayerCfg[bsp->layer].FBStartAdress = bsp->back_buffer_address;
+}
+
+static void driver_sync_rect(void *instance, uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+	const lcd_ui_bsp_instance_t *bsp = (const lcd_ui_bsp_instance_t *)instance;
+	const uint32_t pitch = screen_pitch(bsp);
+	const uint32_t offset = 4U * ((uint32_t)y * pitch + x);
+
+	dma2d_copy(bsp->front_buffer_address + offset,
+		   bsp->back_buffer_address + offset,
+		   w, h, pitch);
+}
+
+#endif /* LCD_UI_BSP_DOUBLE_BUFFER */
+
+static void driver_init(void *instance)
+{
+	lcd_ui_bsp_instance_t *bsp = (lcd_ui_bsp_instance_t *)instance;
+
+	(void)BSP_LCD_Init(bsp->lcd_instance, LCD_ORIENTATION_LANDSCAPE);
 	UTIL_LCD_SetFuncDriver(&LCD_Driver);
-	UTIL_LCD_SetLayer(0);
+	UTIL_LCD_SetLayer(bsp->layer);
 	UTIL_LCD_SetFont(&Font24);
 	UTIL_LCD_SetTextColor(UTIL_LCD_COLOR_WHITE);
+
+	/* Cycle counter backs get_time_us */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+	bsp->time_cycles = DWT->CYCCNT;
+	bsp->time_us = 0U;
+
+#ifdef LCD_UI_BSP_DOUBLE_BUFFER
+	/* Panel keeps scanning the front buffer while everything draws off-screen */
+	hlcd_ltdc.LayerCfg[bsp->layer].FBStartAdress = bsp->back_buffer_address;
+#endif
 }
 
-static void driver_set_backlight(uint8_t level)
+static void driver_set_backlight(void *instance, uint8_t level)
 {
 	// Implement later
+	(void)instance;
 	(void)level;
 }
 
-static void driver_draw_pixel(uint16_t x, uint16_t y, uint32_t colour)
+static void driver_draw_pixel(void *instance, uint16_t x, uint16_t y, uint32_t colour)
 {
+	(void)select_instance(instance);
 	UTIL_LCD_DrawLine((uint32_t)x,
 			  (uint32_t)y,
 			  (uint32_t)x,
@@ -43,17 +150,20 @@ static void driver_draw_pixel(uint16_t x, uint16_t y, uint32_t colour)
 			  colour);
 }
 
-static void driver_draw_rect(uint16_t x,
+static void driver_draw_rect(void *instance,
+			     uint16_t x,
 			     uint16_t y,
 			     uint16_t w,
 			     uint16_t h,
 			     uint32_t colour)
 {
+	(void)select_instance(instance);
 	UTIL_LCD_SetTextColor(colour);
 	UTIL_LCD_FillRect(x, y, w, h, colour);
 }
 
-static void driver_draw_text(uint16_t x,
+static void driver_draw_text(void *instance,
+			     uint16_t x,
 			     uint16_t y,
 			     const char *text,
 			     uint32_t colour,
@@ -66,37 +176,136 @@ static void driver_draw_text(uint16_t x,
 	else if (align == LCD_UI_ALIGN_RIGHT)
 		stm_align = RIGHT_MODE;
 
+	(void)select_instance(instance);
 	UTIL_LCD_SetTextColor(colour);
 	UTIL_LCD_SetBackColor(background_colour);
 	UTIL_LCD_DisplayStringAt(x, y, (uint8_t *)text, stm_align);
 }
 
-static void driver_clear(uint32_t colour)
+static void driver_clear(void *instance, uint32_t colour)
 {
+	(void)select_instance(instance);
 	UTIL_LCD_Clear(colour);
 }
 
-static void driver_get_screen_size(uint16_t *w, uint16_t *h)
+static uint8_t driver_get_framebuffer(void *instance, lcd_ui_framebuffer_t *framebuffer)
+{
+	const lcd_ui_bsp_instance_t *bsp = (const lcd_ui_bsp_instance_t *)instance;
+	uint32_t x = 0, y = 0;
+	(void)BSP_LCD_GetXSize(bsp->lcd_instance, &x);
+	(void)BSP_LCD_GetYSize(bsp->lcd_instance, &y);
+
+	framebuffer->pixels = (void *)(uintptr_t)hlcd_ltdc.LayerCfg[bsp->layer].FBStartAdress;
+	framebuffer->width = (uint16_t)x;
+	framebuffer->height = (uint16_t)y;
+	framebuffer->stride = (uint16_t)x;
+	framebuffer->format = LCD_UI_PIXEL_ARGB8888;
+	return 1U;
+}
+
+static void driver_copy_rect(void *instance,
+			     uint16_t src_x, uint16_t src_y,
+			     uint16_t w, uint16_t h,
+			     uint16_t dst_x, uint16_t dst_y)
+{
+	const lcd_ui_bsp_instance_t *bsp = (const lcd_ui_bsp_instance_t *)instance;
+	const uint32_t pitch = screen_pitch(bsp);
+	const uint32_t base = hlcd_ltdc.LayerCfg[bsp->layer].FBStartAdress;
+	const uint8_t overlap = (src_x < dst_x + w) && (dst_x < src_x + w) &&
+				(src_y < dst_y + h) && (dst_y < src_y + h);
+
+	/* DMA2D streams forwards, so it is safe unless the destination lies
+	   after an overlapping source. Those moves go in non-overlapping
+	   bands taken from the far end. */
+	if (overlap && (dst_y > src_y))
+	{
+		const uint16_t band = dst_y - src_y;
+		uint16_t remaining = h;
+
+		while (remaining > 0U)
+		{
+			uint16_t rows = (remaining < band) ? remaining : band;
+			remaining -= rows;
+			dma2d_copy(base + 4U * ((src_y + remaining) * pitch + src_x),
+				   base + 4U * ((dst_y + remaining) * pitch + dst_x),
+				   w, rows, pitch);
+		}
+	}
+	else if (overlap && (dst_y == src_y) && (dst_x > src_x))
+	{
+		const uint16_t band = dst_x - src_x;
+		uint16_t remaining = w;
+
+		while (remaining > 0U)
+		{
+			uint16_t columns = (remaining < band) ? remaining : band;
+			remaining -= columns;
+			dma2d_copy(base + 4U * (src_y * pitch + src_x + remaining),
+				   base + 4U * (dst_y * pitch + dst_x + remaining),
+				   columns, h, pitch);
+		}
+	}
+	else
+	{
+		dma2d_copy(base + 4U * (src_y * pitch + src_x),
+			   base + 4U * (dst_y * pitch + dst_x),
+			   w, h, pitch);
+	}
+}
+
+static void driver_get_screen_size(void *instance, uint16_t *w, uint16_t *h)
 {
+	const lcd_ui_bsp_instance_t *bsp = (const lcd_ui_bsp_instance_t *)instance;
 	uint32_t x = 0, y = 0;
-	(void)BSP_LCD_GetXSize(0, &x);
-	(void)BSP_LCD_GetYSize(0, &y);
+	(void)BSP_LCD_GetXSize(bsp->lcd_instance, &x);
+	(void)BSP_LCD_GetYSize(bsp->lcd_instance, &y);
 	*w = (uint16_t)x;
 	*h = (uint16_t)y;
 }
 
-static uint16_t driver_get_font_width(void)
+static uint16_t driver_get_font_width(void *instance)
 {
+	(void)select_instance(instance);
 	const sFONT *font = UTIL_LCD_GetFont();
 	return font->Width;
 }
 
-static uint16_t driver_get_font_height(void)
+static uint16_t driver_get_font_height(void *instance)
 {
+	(void)select_instance(instance);
 	const sFONT *font = UTIL_LCD_GetFont();
 	return font->Height;
 }
 
+static const uint8_t *driver_get_glyph(void *instance, char c)
+{
+	(void)select_instance(instance);
+	const sFONT *font = UTIL_LCD_GetFont();
+	const uint32_t glyph_bytes = font->Height * ((font->Width + 7U) / 8U);
+
+	/* Font tables start at ' ' and stop after '~' */
+	if ((c < ' ') || (c > '~'))
+		return NULL;
+
+	return &font->table[(uint32_t)(c - ' ') * glyph_bytes];
+}
+
+/**
+ * @brief Microseconds from the DWT cycle counter. Whole microseconds are
+ *        carried into time_us so the count wraps at 2^32 us, not at the
+ *        cycle counter's period. Call at least once per cycle counter wrap.
+ */
+static uint32_t driver_get_time_us(void *instance)
+{
+	lcd_ui_bsp_instance_t *bsp = (lcd_ui_bsp_instance_t *)instance;
+	const uint32_t cycles_per_us = SystemCoreClock / 1000000U;
+	const uint32_t elapsed_us = (DWT->CYCCNT - bsp->time_cycles) / cycles_per_us;
+
+	bsp->time_cycles += elapsed_us * cycles_per_us;
+	bsp->time_us += elapsed_us;
+	return bsp->time_us;
+}
+
 /* Define the driver struct for the board */
 const lcd_ui_driver_t lcd_ui_bsp_driver = {
     .init = driver_init,
@@ -108,4 +317,12 @@ const lcd_ui_driver_t lcd_ui_bsp_driver = {
     .get_screen_size = driver_get_screen_size,
     .get_font_width = driver_get_font_width,
     .get_font_height = driver_get_font_height,
+#ifdef LCD_UI_BSP_DOUBLE_BUFFER
+    .flip = driver_flip,
+    .sync_rect = driver_sync_rect,
+#endif
+    .get_framebuffer = driver_get_framebuffer,
+    .copy_rect = driver_copy_rect,
+    .get_glyph = driver_get_glyph,
+    .get_time_us = driver_get_time_us,
 };
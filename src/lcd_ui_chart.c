@@ -0,0 +1,490 @@
+/**
+ * @file        lcd_ui_chart.c
+ * @brief       Scrolling real-time chart widget backed by a ring buffer.
+ *
+ * @author      Ryan Hicks <c3361231@uon.edu.au>
+ *              School of Engineering (Electrical and Computer Engineering)
+ *              University of Newcastle
+ *
+ * @date        2025-04-11
+ * @version     1.0.0
+ *
+ * @copyright   Copyright (c) 2025 Ryan
+ * @license     SPDX-License-Identifier: MIT
+ *
+ * @note        Redistribution and use permitted with attribution.
+ */
+
+#include "lcd_ui_chart.h"
+
+/**
+ * @brief The sample @p age places back from the newest (0 = newest).
+ */
+static int32_t sample_at(const lcd_ui_chart_t *chart, uint16_t age)
+{
+	uint32_t index = (uint32_t)chart->head + chart->capacity - 1U - age;
+	if (index >= chart->capacity)
+		index -= chart->capacity;
+	return lcd_ui_sample_read(&chart->source, index);
+}
+
+/**
+ * @brief Screen row of a value, clamped to the widget.
+ */
+static uint16_t sample_row(const lcd_ui_chart_t *chart,
+			   const lcd_ui_widget_t *widget,
+			   int32_t sample)
+{
+	const uint16_t bottom = widget->y + widget->height - 1U;
+
+	if (sample <= chart->minimum)
+		return bottom;
+	if (sample >= chart->maximum)
+		return widget->y;
+
+	return bottom - (uint16_t)(((int64_t)sample - chart->minimum) * (widget->height - 1U) /
+				   ((int64_t)chart->maximum - chart->minimum));
+}
+
+/**
+ * @brief Sets a new range with an eighth of headroom on both sides, so
+ *        small excursions do not trigger another full redraw.
+ */
+static void set_range(lcd_ui_chart_t *chart, int32_t low, int32_t high)
+{
+	int64_t pad = ((int64_t)high - low) / 8;
+	int64_t minimum;
+	int64_t maximum;
+
+	if (pad < 1)
+		pad = 1;
+
+	minimum = (int64_t)low - pad;
+	maximum = (int64_t)high + pad;
+
+	chart->minimum = (minimum < INT32_MIN) ? INT32_MIN : (int32_t)minimum;
+	chart->maximum = (maximum > INT32_MAX) ? INT32_MAX : (int32_t)maximum;
+	chart->rescaled = 1U;
+}
+
+/**
+ * @brief Refits the range to the samples on screen if they have left it
+ *        or shrunk to under half of it.
+ */
+static void fit_range(lcd_ui_chart_t *chart, uint16_t columns)
+{
+	int32_t low;
+	int32_t high;
+
+	if (chart->count == 0U)
+		return;
+
+	if (columns > chart->count)
+		columns = chart->count;
+
+	low = high = sample_at(chart, 0U);
+	for (uint16_t age = 1U; age < columns; ++age)
+	{
+		const int32_t sample = sample_at(chart, age);
+		if (sample < low)
+			low = sample;
+		if (sample > high)
+			high = sample;
+	}
+
+	if ((low < chart->minimum) || (high > chart->maximum) ||
+	    (((int64_t)high - low) * 2 < ((int64_t)chart->maximum - chart->minimum)))
+	{
+		set_range(chart, low, high);
+	}
+}
+
+/**
+ * @brief Takes in samples the producer has completed since the last
+ *        update, as if each had been pushed.
+ */
+static void take_completed(lcd_ui_chart_t *chart)
+{
+	const uint32_t completed = chart->completed;
+	uint32_t added = completed - chart->consumed;
+
+	chart->consumed = completed;
+	if ((added == 0U) || (chart->capacity == 0U))
+		return;
+
+	chart->head = (uint16_t)((chart->head + added % chart->capacity) % chart->capacity);
+	chart->count = (chart->count + added > chart->capacity) ? chart->capacity
+								   : (uint16_t)(chart->count + added);
+	chart->pending = (chart->pending + added > UINT16_MAX) ? UINT16_MAX
+								: (uint16_t)(chart->pending + added);
+
+	if (chart->scale == LCD_UI_CHART_SCALE_EXPAND)
+	{
+		/* More than a lap behind: only the latest lap is still there */
+		const uint16_t fresh = (added > chart->capacity) ? chart->capacity : (uint16_t)added;
+		int32_t low = chart->minimum;
+		int32_t high = chart->maximum;
+
+		for (uint16_t age = 0U; age < fresh; ++age)
+		{
+			const int32_t sample = sample_at(chart, age);
+			if (sample < low)
+				low = sample;
+			if (sample > high)
+				high = sample;
+		}
+
+		if ((low < chart->minimum) || (high > chart->maximum))
+			set_range(chart, low, high);
+	}
+}
+
+/**
+ * @brief The sample window a decimated chart shows.
+ */
+static void view_window(const lcd_ui_chart_t *chart, uint32_t *start, uint32_t *length)
+{
+	const uint32_t count = chart->pyramid->count;
+
+	*start = (chart->view_start < count) ? chart->view_start : count;
+	*length = (chart->view_length == 0U) ? (count - *start) : chart->view_length;
+	if (*length > count - *start)
+		*length = count - *start;
+}
+
+/**
+ * @brief Brings a decimated chart's range in line with its scale mode,
+ *        using the pyramid rather than the samples.
+ */
+static void fit_decimated(lcd_ui_chart_t *chart)
+{
+	uint32_t start;
+	uint32_t length;
+	lcd_ui_minmax_t extremes;
+
+	if (chart->scale == LCD_UI_CHART_SCALE_FIXED)
+		return;
+
+	if (chart->scale == LCD_UI_CHART_SCALE_EXPAND)
+	{
+		start = 0U;
+		length = chart->pyramid->count;
+	}
+	else
+	{
+		view_window(chart, &start, &length);
+	}
+
+	if (length == 0U)
+		return;
+
+	extremes = lcd_ui_pyramid_range(chart->pyramid, start, start + length);
+
+	if ((extremes.minimum < chart->minimum) || (extremes.maximum > chart->maximum))
+	{
+		set_range(chart,
+			  (chart->scale == LCD_UI_CHART_SCALE_EXPAND && chart->minimum < extremes.minimum)
+			      ? chart->minimum
+			      : extremes.minimum,
+			  (chart->scale == LCD_UI_CHART_SCALE_EXPAND && chart->maximum > extremes.maximum)
+			      ? chart->maximum
+			      : extremes.maximum);
+	}
+	else if ((chart->scale == LCD_UI_CHART_SCALE_FIT) &&
+		 (((int64_t)extremes.maximum - extremes.minimum) * 2 <
+		  ((int64_t)chart->maximum - chart->minimum)))
+	{
+		set_range(chart, extremes.minimum, extremes.maximum);
+	}
+}
+
+/**
+ * @brief Draws columns [first, last) of a decimated chart, each as the
+ *        span from its minimum to its maximum, stretched to meet the
+ *        column before so the trace stays joined.
+ */
+static void draw_decimated(lcd_ui_context_t *ctx,
+			   const lcd_ui_widget_t *widget,
+			   lcd_ui_chart_t *chart,
+			   uint16_t first, uint16_t last,
+			   uint32_t foreground)
+{
+	uint32_t start;
+	uint32_t length;
+	lcd_ui_minmax_t previous;
+	uint16_t column = first - widget->x;
+
+	view_window(chart, &start, &length);
+	if (length == 0U)
+		return;
+
+	/* Columns past the end of a short series stay empty */
+	if (length < widget->width)
+	{
+		const uint16_t used = (uint16_t)length;
+		if (last > widget->x + used)
+			last = widget->x + used;
+		if (first >= last)
+			return;
+	}
+
+	const uint16_t columns = (length < widget->width) ? (uint16_t)length : widget->width;
+
+	previous.minimum = 0;
+	previous.maximum = 0;
+
+	for (uint16_t x = first; x < last; ++x, ++column)
+	{
+		const uint32_t from = start + (uint32_t)(((uint64_t)length * column) / columns);
+		uint32_t to = start + (uint32_t)(((uint64_t)length * (column + 1U)) / columns);
+		if (to <= from)
+			to = from + 1U;
+
+		lcd_ui_minmax_t extremes = lcd_ui_pyramid_range(chart->pyramid, from, to);
+		lcd_ui_minmax_t span = extremes;
+
+		if (column > 0U)
+		{
+			if (column == first - widget->x)
+			{
+				const uint32_t before = start + (uint32_t)(((uint64_t)length * (column - 1U)) / columns);
+				previous = lcd_ui_pyramid_range(chart->pyramid, before, (from > before) ? from : before + 1U);
+			}
+			if (previous.maximum < span.minimum)
+				span.minimum = previous.maximum;
+			if (previous.minimum > span.maximum)
+				span.maximum = previous.minimum;
+		}
+
+		const uint16_t top = sample_row(chart, widget, span.maximum);
+		const uint16_t bottom = sample_row(chart, widget, span.minimum);
+		lcd_ui_fill_rect(ctx, x, top, 1U, bottom - top + 1U, foreground);
+
+		previous = extremes;
+	}
+}
+
+void lcd_ui_chart_init(lcd_ui_chart_t *chart,
+		       int32_t *samples, uint16_t capacity,
+		       int32_t minimum, int32_t maximum,
+		       lcd_ui_chart_scale_t scale)
+{
+	if (!chart)
+		return;
+
+	const lcd_ui_samples_t source = LCD_UI_SAMPLES(samples, LCD_UI_SAMPLE_INT32);
+
+	lcd_ui_chart_init_source(chart, &source, capacity, minimum, maximum, scale);
+	chart->samples = samples;
+}
+
+void lcd_ui_chart_init_source(lcd_ui_chart_t *chart,
+			      const lcd_ui_samples_t *source, uint16_t capacity,
+			      int32_t minimum, int32_t maximum,
+			      lcd_ui_chart_scale_t scale)
+{
+	if (!chart || !source)
+		return;
+
+	/* An empty range becomes one unit wide, without overflowing */
+	if (maximum <= minimum)
+	{
+		if (minimum == INT32_MAX)
+			minimum = INT32_MAX - 1;
+		maximum = minimum + 1;
+	}
+
+	chart->source = *source;
+	chart->samples = NULL;
+	chart->capacity = source->base ? capacity : 0U;
+	chart->count = 0U;
+	chart->head = 0U;
+	chart->pending = 0U;
+	chart->completed = 0U;
+	chart->consumed = 0U;
+	chart->minimum = minimum;
+	chart->maximum = maximum;
+	chart->scale = scale;
+	chart->rescaled = 1U;
+	chart->pyramid = NULL;
+	chart->view_start = 0U;
+	chart->view_length = 0U;
+	chart->view_count = 0U;
+}
+
+void lcd_ui_chart_buffer_complete(lcd_ui_chart_t *chart, uint8_t full)
+{
+	if (!chart)
+		return;
+
+	/* Only the ISR writes completed, so no lock is needed */
+	const uint16_t half = chart->capacity / 2U;
+	chart->completed += full ? (uint32_t)(chart->capacity - half) : half;
+}
+
+void lcd_ui_chart_init_decimated(lcd_ui_chart_t *chart,
+				 const lcd_ui_pyramid_t *pyramid,
+				 int32_t minimum, int32_t maximum,
+				 lcd_ui_chart_scale_t scale)
+{
+	lcd_ui_chart_init(chart, NULL, 0U, minimum, maximum, scale);
+	if (chart)
+		chart->pyramid = pyramid;
+}
+
+void lcd_ui_chart_set_view(lcd_ui_context_t *ctx, lcd_ui_widget_t *widget,
+			   uint32_t start, uint32_t length)
+{
+	if (!ctx || !widget || (widget->type != LCD_UI_WIDGET_CHART) || !widget->data)
+		return;
+
+	lcd_ui_chart_t *chart = (lcd_ui_chart_t *)widget->data;
+	if (!chart->pyramid)
+		return;
+
+	chart->view_start = start;
+	chart->view_length = length;
+	fit_decimated(chart);
+	lcd_ui_redraw_widget(ctx, widget);
+}
+
+void lcd_ui_chart_push(lcd_ui_chart_t *chart, int32_t sample)
+{
+	if (!chart || !chart->samples || (chart->capacity == 0U))
+		return;
+
+	chart->samples[chart->head] = sample;
+	chart->head = (uint16_t)((chart->head + 1U == chart->capacity) ? 0U : (chart->head + 1U));
+
+	if (chart->count < chart->capacity)
+		++chart->count;
+	if (chart->pending < UINT16_MAX)
+		++chart->pending;
+
+	if ((chart->scale == LCD_UI_CHART_SCALE_EXPAND) &&
+	    ((sample < chart->minimum) || (sample > chart->maximum)))
+	{
+		set_range(chart,
+			  (sample < chart->minimum) ? sample : chart->minimum,
+			  (sample > chart->maximum) ? sample : chart->maximum);
+	}
+}
+
+void lcd_ui_chart_update(lcd_ui_context_t *ctx, lcd_ui_widget_t *widget)
+{
+	if (!ctx || !widget || (widget->type != LCD_UI_WIDGET_CHART) || !widget->data)
+		return;
+
+	lcd_ui_chart_t *chart = (lcd_ui_chart_t *)widget->data;
+
+	if (chart->pyramid)
+	{
+		/* No scrolling: columns are re-binned as the series grows */
+		fit_decimated(chart);
+		if (chart->rescaled || (chart->pyramid->count != chart->view_count))
+			lcd_ui_redraw_widget(ctx, widget);
+		return;
+	}
+
+	take_completed(chart);
+
+	if (chart->scale == LCD_UI_CHART_SCALE_FIT)
+		fit_range(chart, widget->width);
+
+	if (chart->rescaled || (chart->pending >= widget->width))
+	{
+		lcd_ui_redraw_widget(ctx, widget);
+	}
+	else if (chart->pending != 0U)
+	{
+		/* The uncovered columns are repainted through lcd_ui_chart_draw() */
+		const lcd_ui_rect_t plot = {widget->x, widget->y, widget->width, widget->height};
+		uint32_t background = 0U;
+
+		lcd_ui_get_widget_colours(ctx, widget, &background, NULL);
+		lcd_ui_scroll_region(ctx, &plot, (int16_t)-(int16_t)chart->pending, 0, background);
+
+		if ((chart->count == chart->capacity) && (chart->capacity <= widget->width))
+		{
+			/* Columns moved past the oldest sample held must be cleared */
+			const uint16_t oldest_x = widget->x + widget->width - chart->capacity;
+			const uint16_t first_x = (oldest_x - widget->x > chart->pending)
+						     ? (oldest_x - chart->pending)
+						     : widget->x;
+			const lcd_ui_rect_t saved_clip = ctx->clip;
+			const lcd_ui_rect_t expired = {first_x, widget->y,
+						       oldest_x + 1U - first_x, widget->height};
+
+			ctx->clip = expired;
+			lcd_ui_redraw_widget(ctx, widget);
+			ctx->clip = saved_clip;
+		}
+	}
+
+	chart->pending = 0U;
+	chart->rescaled = 0U;
+}
+
+void lcd_ui_chart_draw(lcd_ui_context_t *ctx,
+		       const lcd_ui_widget_t *widget,
+		       uint32_t background, uint32_t foreground)
+{
+	if (!ctx || !widget)
+		return;
+
+	lcd_ui_chart_t *chart = (lcd_ui_chart_t *)widget->data;
+
+	/* Only the columns inside the clip, so scroll repaints stay O(new) */
+	uint16_t first = widget->x;
+	uint16_t last = widget->x + widget->width;
+	if (first < ctx->clip.x)
+		first = ctx->clip.x;
+	if (last > ctx->clip.x + ctx->clip.width)
+		last = ctx->clip.x + ctx->clip.width;
+	if (first >= last)
+		return;
+
+	lcd_ui_fill_rect(ctx, first, widget->y, last - first, widget->height, background);
+
+	if (!chart)
+		return;
+
+	const uint8_t whole = (first == widget->x) && (last == widget->x + widget->width) &&
+			      (ctx->clip.y <= widget->y) &&
+			      (ctx->clip.y + ctx->clip.height >= widget->y + widget->height);
+
+	if (chart->pyramid)
+	{
+		draw_decimated(ctx, widget, chart, first, last, foreground);
+		if (whole)
+		{
+			chart->view_count = chart->pyramid->count;
+			chart->rescaled = 0U;
+		}
+		return;
+	}
+
+	for (uint16_t x = first; x < last; ++x)
+	{
+		const uint16_t age = (uint16_t)(widget->x + widget->width - 1U - x);
+		if (age >= chart->count)
+			continue;
+
+		/* Join each sample to the one before it with a vertical span */
+		const uint16_t row = sample_row(chart, widget, sample_at(chart, age));
+		const uint16_t previous = (age + 1U < chart->count)
+					      ? sample_row(chart, widget, sample_at(chart, age + 1U))
+					      : row;
+		const uint16_t top = (row < previous) ? row : previous;
+		const uint16_t bottom = (row < previous) ? previous : row;
+
+		lcd_ui_fill_rect(ctx, x, top, 1U, bottom - top + 1U, foreground);
+	}
+
+	/* A draw of the whole plot brings it up to date */
+	if (whole)
+	{
+		chart->pending = 0U;
+		chart->rescaled = 0U;
+	}
+}
@@ -0,0 +1,220 @@
+/**
+ * @file        lcd_ui_decimate.c
+ * @brief       Min/max pyramid for plotting long series at pixel resolution.
+ *
+ * @author      Ryan Hicks <c3361231@uon.edu.au>
+ *              School of Engineering (Electrical and Computer Engineering)
+ *              University of Newcastle
+ *
+ * @date        2025-04-11
+ * @version     1.0.0
+ *
+ * @copyright   Copyright (c) 2025 Ryan
+ * @license     SPDX-License-Identifier: MIT
+ *
+ * @note        Redistribution and use permitted with attribution.
+ */
+
+#include "lcd_ui_decimate.h"
+
+#include <string.h>
+
+/**
+ * @brief Samples covered by one node at @p level (level 0 = one sample).
+ */
+static uint64_t block_size(uint8_t level)
+{
+	return (uint64_t)1U << (LCD_UI_PYRAMID_SHIFT * level);
+}
+
+uint32_t lcd_ui_pyramid_nodes_needed(uint32_t capacity)
+{
+	uint32_t total = 0U;
+	uint64_t nodes = capacity;
+
+	while (nodes > 1U)
+	{
+		nodes = (nodes + block_size(1U) - 1U) >> LCD_UI_PYRAMID_SHIFT;
+		total += (uint32_t)nodes;
+	}
+
+	return total;
+}
+
+uint8_t lcd_ui_pyramid_init(lcd_ui_pyramid_t *pyramid,
+			    int32_t *samples, uint32_t capacity,
+			    lcd_ui_minmax_t *nodes, uint32_t node_count)
+{
+	const lcd_ui_samples_t source = LCD_UI_SAMPLES(samples, LCD_UI_SAMPLE_INT32);
+
+	if (!samples || !lcd_ui_pyramid_init_source(pyramid, &source, capacity, nodes, node_count))
+		return 0U;
+
+	pyramid->samples = samples;
+	return 1U;
+}
+
+uint8_t lcd_ui_pyramid_init_source(lcd_ui_pyramid_t *pyramid,
+				   const lcd_ui_samples_t *source, uint32_t capacity,
+				   lcd_ui_minmax_t *nodes, uint32_t node_count)
+{
+	uint64_t level_nodes = capacity;
+	uint32_t offset = 0U;
+
+	if (!pyramid || !source || !source->base || (!nodes && (capacity > 1U)) ||
+	    (node_count < lcd_ui_pyramid_nodes_needed(capacity)))
+		return 0U;
+
+	memset(pyramid, 0, sizeof(*pyramid));
+	pyramid->source = *source;
+	pyramid->capacity = capacity;
+	pyramid->nodes = nodes;
+
+	while (level_nodes > 1U)
+	{
+		level_nodes = (level_nodes + block_size(1U) - 1U) >> LCD_UI_PYRAMID_SHIFT;
+		++pyramid->levels;
+		pyramid->level_offset[pyramid->levels] = offset;
+		offset += (uint32_t)level_nodes;
+	}
+
+	return 1U;
+}
+
+/**
+ * @brief Folds the samples [first, end) into every level above them.
+ */
+static void update_nodes(lcd_ui_pyramid_t *pyramid, uint32_t first, uint32_t end)
+{
+	for (uint32_t i = first; i < end; ++i)
+	{
+		const int32_t sample = lcd_ui_sample_read(&pyramid->source, i);
+
+		for (uint8_t level = 1U; level <= pyramid->levels; ++level)
+		{
+			const uint8_t shift = (uint8_t)(LCD_UI_PYRAMID_SHIFT * level);
+			lcd_ui_minmax_t *node = &pyramid->nodes[pyramid->level_offset[level] +
+								(uint32_t)((uint64_t)i >> shift)];
+
+			if (((uint64_t)i & (block_size(level) - 1U)) == 0U)
+			{
+				/* First sample of this block */
+				node->minimum = sample;
+				node->maximum = sample;
+				continue;
+			}
+
+			if (sample < node->minimum)
+				node->minimum = sample;
+			else if (sample > node->maximum)
+				node->maximum = sample;
+			else
+				break; /* no change here means none further up */
+		}
+	}
+}
+
+void lcd_ui_pyramid_append(lcd_ui_pyramid_t *pyramid,
+			   const int32_t *samples, uint32_t count)
+{
+	if (!pyramid || !pyramid->samples || !samples)
+		return;
+
+	if (count > pyramid->capacity - pyramid->count)
+		count = pyramid->capacity - pyramid->count;
+
+	memcpy(&pyramid->samples[pyramid->count], samples, (size_t)count * sizeof(int32_t));
+	lcd_ui_pyramid_extend(pyramid, count);
+}
+
+void lcd_ui_pyramid_extend(lcd_ui_pyramid_t *pyramid, uint32_t count)
+{
+	if (!pyramid)
+		return;
+
+	if (count > pyramid->capacity - pyramid->count)
+		count = pyramid->capacity - pyramid->count;
+
+	update_nodes(pyramid, pyramid->count, pyramid->count + count);
+	pyramid->count += count;
+}
+
+lcd_ui_minmax_t lcd_ui_pyramid_range(const lcd_ui_pyramid_t *pyramid,
+				     uint32_t start, uint32_t end)
+{
+	lcd_ui_minmax_t result = {INT32_MAX, INT32_MIN};
+	uint64_t position = start;
+
+	if (!pyramid)
+		return result;
+
+	if (end > pyramid->count)
+		end = pyramid->count;
+
+	uint8_t level = 0U;
+
+	while (position < end)
+	{
+		/* Take the largest whole block that starts here and fits. The
+		   previous block leaves position aligned to its own level, so
+		   the search carries on from there. */
+		while ((level < pyramid->levels) &&
+		       ((position & (block_size(level + 1U) - 1U)) == 0U) &&
+		       (end - position >= block_size(level + 1U)))
+		{
+			++level;
+		}
+		while ((level > 0U) && (end - position < block_size(level)))
+		{
+			--level;
+		}
+
+		int32_t minimum;
+		int32_t maximum;
+		if (level == 0U)
+		{
+			minimum = maximum = lcd_ui_sample_read(&pyramid->source, (uint32_t)position);
+		}
+		else
+		{
+			const lcd_ui_minmax_t *node =
+			    &pyramid->nodes[pyramid->level_offset[level] +
+					    (uint32_t)(position >> (LCD_UI_PYRAMID_SHIFT * level))];
+			minimum = node->minimum;
+			maximum = node->maximum;
+		}
+
+		if (minimum < result.minimum)
+			result.minimum = minimum;
+		if (maximum > result.maximum)
+			result.maximum = maximum;
+
+		position += block_size(level);
+	}
+
+	return result;
+}
+
+void lcd_ui_pyramid_envelope(const lcd_ui_pyramid_t *pyramid,
+			     uint32_t start, uint32_t length,
+			     uint16_t columns, lcd_ui_minmax_t *envelope)
+{
+	if (!pyramid || !envelope || (columns == 0U) || (start >= pyramid->count))
+		return;
+
+	if (length > pyramid->count - start)
+		length = pyramid->count - start;
+
+	for (uint16_t column = 0U; column < columns; ++column)
+	{
+		uint32_t first = start + (uint32_t)(((uint64_t)length * column) / columns);
+		uint32_t end = start + (uint32_t)(((uint64_t)length * (column + 1U)) / columns);
+
+		if (end <= first)
+			end = first + 1U;
+		if (first >= pyramid->count)
+			first = pyramid->count - 1U;
+
+		envelope[column] = lcd_ui_pyramid_range(pyramid, first, end);
+	}
+}
@@ -0,0 +1,355 @@
+/**
+ * @file        lcd_ui_gauge.c
+ * @brief       Circular gauge widget with a cached dial face.
+ *
+ * @author      Ryan Hicks <c3361231@uon.edu.au>
+ *              School of Engineering (Electrical and Computer Engineering)
+ *              University of Newcastle
+ *
+ * @date        2025-04-11
+ * @version     1.0.0
+ *
+ * @copyright   Copyright (c) 2025 Ryan
+ * @license     SPDX-License-Identifier: MIT
+ *
+ * @note        Redistribution and use permitted with attribution.
+ */
+
+#include "lcd_ui_gauge.h"
+#include "lcd_ui_shapes.h"
+
+#include <string.h>
+
+/**
+ * @brief Centre and radius of the dial within a widget.
+ */
+typedef struct
+{
+	int32_t cx;
+	int32_t cy;
+	int32_t radius;
+} dial_t;
+
+/**
+ * @brief Needle end points, in LCD_UI_SUBPIXEL units, and hub size.
+ */
+typedef struct
+{
+	int32_t tip_x;
+	int32_t tip_y;
+	int32_t tail_x;
+	int32_t tail_y;
+	int32_t hub;
+} needle_t;
+
+static dial_t dial_of(const lcd_ui_widget_t *widget)
+{
+	const uint16_t size = (widget->width < widget->height) ? widget->width : widget->height;
+	dial_t dial;
+
+	dial.cx = widget->x + widget->width / 2;
+	dial.cy = widget->y + widget->height / 2;
+	dial.radius = (size > 3U) ? (size / 2 - 1) : 1;
+	return dial;
+}
+
+/**
+ * @brief Rounds a Q14 product to the nearest integer.
+ */
+static int32_t round_q14(int32_t value)
+{
+	return (value >= 0) ? ((value + 8192) / 16384) : -((8192 - value) / 16384);
+}
+
+/**
+ * @brief Angle of a value in LCD_UI_ANGLE_TURN units.
+ */
+static int32_t angle_of(const lcd_ui_gauge_t *gauge, int32_t value)
+{
+	const int32_t start = (int32_t)gauge->start_angle * (int32_t)LCD_UI_ANGLE_TURN / 360;
+	const int32_t sweep = (int32_t)gauge->sweep * (int32_t)LCD_UI_ANGLE_TURN / 360;
+
+	return start + (int32_t)(((int64_t)value - gauge->minimum) * sweep /
+				 ((int64_t)gauge->maximum - gauge->minimum));
+}
+
+/**
+ * @brief The point @p distance from the centre at @p angle (clockwise
+ *        from 12 o'clock), in @p scale units per pixel.
+ */
+static void point_at(const dial_t *dial, int32_t angle, int32_t distance, int32_t scale,
+		     int32_t *x, int32_t *y)
+{
+	*x = dial->cx * scale + round_q14(distance * scale * lcd_ui_sin((uint16_t)angle));
+	*y = dial->cy * scale - round_q14(distance * scale * lcd_ui_cos((uint16_t)angle));
+}
+
+static needle_t needle_of(const lcd_ui_gauge_t *gauge, const dial_t *dial)
+{
+	const int32_t angle = angle_of(gauge, gauge->value);
+	needle_t needle;
+
+	point_at(dial, angle, dial->radius - dial->radius / 8 - 2, LCD_UI_SUBPIXEL,
+		 &needle.tip_x, &needle.tip_y);
+	point_at(dial, angle + (int32_t)LCD_UI_ANGLE_TURN / 2, dial->radius / 8, LCD_UI_SUBPIXEL,
+		 &needle.tail_x, &needle.tail_y);
+	needle.hub = gauge->needle_width + 2;
+	return needle;
+}
+
+/**
+ * @brief Everything the needle and hub can touch, cut to the widget.
+ */
+static lcd_ui_rect_t needle_box(const lcd_ui_widget_t *widget, const needle_t *needle)
+{
+	int32_t left = ((needle->tip_x < needle->tail_x) ? needle->tip_x : needle->tail_x) / LCD_UI_SUBPIXEL;
+	int32_t right = ((needle->tip_x > needle->tail_x) ? needle->tip_x : needle->tail_x) / LCD_UI_SUBPIXEL + 1;
+	int32_t top = ((needle->tip_y < needle->tail_y) ? needle->tip_y : needle->tail_y) / LCD_UI_SUBPIXEL;
+	int32_t bottom = ((needle->tip_y > needle->tail_y) ? needle->tip_y : needle->tail_y) / LCD_UI_SUBPIXEL + 1;
+	lcd_ui_rect_t box;
+
+	/* The hub is the widest part and sits between the ends */
+	left -= needle->hub;
+	top -= needle->hub;
+	right += needle->hub + 1;
+	bottom += needle->hub + 1;
+
+	if (left < widget->x)
+		left = widget->x;
+	if (top < widget->y)
+		top = widget->y;
+	if (right > widget->x + widget->width)
+		right = widget->x + widget->width;
+	if (bottom > widget->y + widget->height)
+		bottom = widget->y + widget->height;
+
+	box.x = (uint16_t)left;
+	box.y = (uint16_t)top;
+	box.width = (right > left) ? (uint16_t)(right - left) : 0U;
+	box.height = (bottom > top) ? (uint16_t)(bottom - top) : 0U;
+	return box;
+}
+
+/**
+ * @brief Repaints @p area, cut to @p clip, through the widget so
+ *        overlays stay on top.
+ */
+static void repair(lcd_ui_context_t *ctx, lcd_ui_widget_t *widget,
+		   const lcd_ui_rect_t *area, const lcd_ui_rect_t *clip)
+{
+	const uint16_t left = (area->x > clip->x) ? area->x : clip->x;
+	const uint16_t top = (area->y > clip->y) ? area->y : clip->y;
+	const uint32_t right = ((uint32_t)area->x + area->width < (uint32_t)clip->x + clip->width)
+				   ? ((uint32_t)area->x + area->width)
+				   : ((uint32_t)clip->x + clip->width);
+	const uint32_t bottom = ((uint32_t)area->y + area->height < (uint32_t)clip->y + clip->height)
+				    ? ((uint32_t)area->y + area->height)
+				    : ((uint32_t)clip->y + clip->height);
+
+	if ((right <= left) || (bottom <= top))
+		return;
+
+	ctx->clip.x = left;
+	ctx->clip.y = top;
+	ctx->clip.width = (uint16_t)(right - left);
+	ctx->clip.height = (uint16_t)(bottom - top);
+	lcd_ui_redraw_widget(ctx, widget);
+	ctx->clip = *clip;
+}
+
+static void format_integer(int32_t value, char *text)
+{
+	char digits[11];
+	uint8_t count = 0U;
+	uint32_t magnitude = (value < 0) ? (0U - (uint32_t)value) : (uint32_t)value;
+
+	do
+	{
+		digits[count++] = (char)('0' + magnitude % 10U);
+		magnitude /= 10U;
+	} while (magnitude != 0U);
+
+	if (value < 0)
+		*text++ = '-';
+	while (count > 0U)
+		*text++ = digits[--count];
+	*text = '\0';
+}
+
+/**
+ * @brief Draws the static dial: disc, ticks and labels. Rendered once
+ *        into the gauge's surface when it has a cache.
+ */
+static void render_face(lcd_ui_context_t *ctx, const lcd_ui_widget_t *widget, void *user_data)
+{
+	const lcd_ui_gauge_t *gauge = (const lcd_ui_gauge_t *)user_data;
+	const lcd_ui_style_t *style = lcd_ui_get_widget_style(ctx, widget);
+	const dial_t dial = dial_of(widget);
+	const uint16_t font_w = ctx->driver->get_font_width(ctx->driver_instance);
+	const uint16_t font_h = ctx->driver->get_font_height(ctx->driver_instance);
+	const uint32_t intervals = (uint32_t)gauge->major_ticks * (gauge->minor_ticks + 1U);
+	uint32_t background = 0U;
+	uint32_t foreground = 0U;
+
+	lcd_ui_get_widget_colours(ctx, widget, &background, &foreground);
+	const uint32_t face = style ? style->shades.focused : lighten_colour(background, 20U);
+
+	lcd_ui_fill_rect(ctx, widget->x, widget->y, widget->width, widget->height, background);
+	lcd_ui_draw_arc_aa(ctx, (int16_t)dial.cx, (int16_t)dial.cy, (uint16_t)dial.radius,
+			   (uint16_t)(dial.radius + 1), 0, 360, face);
+
+	for (uint32_t i = 0U; i <= intervals; ++i)
+	{
+		const uint8_t is_major = ((i % (gauge->minor_ticks + 1U)) == 0U);
+		const int32_t value = (int32_t)(gauge->minimum +
+						((int64_t)gauge->maximum - gauge->minimum) * i / intervals);
+		const int32_t angle = angle_of(gauge, value);
+		const int32_t inner = dial.radius - (is_major ? dial.radius / 8 : dial.radius / 16);
+		int32_t x0, y0, x1, y1;
+
+		point_at(&dial, angle, dial.radius - 1, LCD_UI_SUBPIXEL, &x0, &y0);
+		point_at(&dial, angle, inner, LCD_UI_SUBPIXEL, &x1, &y1);
+		lcd_ui_draw_line_aa(ctx, x0, y0, x1, y1,
+				    is_major ? 2U * LCD_UI_SUBPIXEL : LCD_UI_SUBPIXEL, foreground);
+
+		if (is_major)
+		{
+			char text[12];
+			int32_t lx, ly;
+
+			format_integer(value, text);
+
+			/* Centred far enough in that the text clears the tick */
+			const int32_t text_w = (int32_t)(font_w * strlen(text));
+			const int32_t extent = (text_w > font_h) ? text_w : font_h;
+
+			point_at(&dial, angle, inner - 2 - extent / 2, 1, &lx, &ly);
+			lx -= text_w / 2;
+			ly -= font_h / 2;
+			if ((lx >= widget->x) && (ly >= widget->y))
+				lcd_ui_draw_text(ctx, (uint16_t)lx, (uint16_t)ly, text, foreground, face);
+		}
+	}
+}
+
+/**
+ * @brief Draws the needle and hub, cut to ctx->clip, and remembers the
+ *        area they cover.
+ */
+static void draw_needle(lcd_ui_context_t *ctx, const lcd_ui_widget_t *widget,
+			lcd_ui_gauge_t *gauge, uint32_t colour)
+{
+	const dial_t dial = dial_of(widget);
+	const needle_t needle = needle_of(gauge, &dial);
+
+	lcd_ui_draw_line_aa(ctx, needle.tail_x, needle.tail_y, needle.tip_x, needle.tip_y,
+			    (uint16_t)(gauge->needle_width * LCD_UI_SUBPIXEL), colour);
+	lcd_ui_draw_arc_aa(ctx, (int16_t)dial.cx, (int16_t)dial.cy, (uint16_t)needle.hub,
+			   (uint16_t)(needle.hub + 1), 0, 360, colour);
+
+	gauge->needle_box = needle_box(widget, &needle);
+	gauge->needle_drawn = 1U;
+}
+
+void lcd_ui_gauge_init(lcd_ui_gauge_t *gauge,
+		       lcd_ui_surface_cache_t *cache,
+		       int32_t minimum, int32_t maximum)
+{
+	if (!gauge)
+		return;
+
+	/* An empty range becomes one unit wide, without overflowing */
+	if (maximum <= minimum)
+	{
+		if (minimum == INT32_MAX)
+			minimum = INT32_MAX - 1;
+		maximum = minimum + 1;
+	}
+
+	gauge->minimum = minimum;
+	gauge->maximum = maximum;
+	gauge->value = minimum;
+	gauge->start_angle = -135;
+	gauge->sweep = 270;
+	gauge->major_ticks = 5U;
+	gauge->minor_ticks = 4U;
+	gauge->needle_width = 3U;
+	gauge->needle_drawn = 0U;
+	gauge->face_cached = (cache != NULL);
+
+	if (cache)
+		lcd_ui_surface_init(cache, &gauge->face, render_face, gauge);
+}
+
+void lcd_ui_gauge_set_value(lcd_ui_context_t *ctx, lcd_ui_widget_t *widget,
+			    int32_t value)
+{
+	if (!ctx || !widget || (widget->type != LCD_UI_WIDGET_GAUGE) || !widget->data)
+		return;
+
+	lcd_ui_gauge_t *gauge = (lcd_ui_gauge_t *)widget->data;
+
+	if (value < gauge->minimum)
+		value = gauge->minimum;
+	if (value > gauge->maximum)
+		value = gauge->maximum;
+	if (value == gauge->value)
+		return;
+
+	gauge->value = value;
+	if (!gauge->needle_drawn)
+		return;
+
+	const dial_t dial = dial_of(widget);
+	const needle_t needle = needle_of(gauge, &dial);
+	const lcd_ui_rect_t old_box = gauge->needle_box;
+	const lcd_ui_rect_t new_box = needle_box(widget, &needle);
+	const lcd_ui_rect_t saved_clip = ctx->clip;
+
+	/* One pass over both boxes when they mostly overlap, else one each */
+	const uint16_t left = (old_box.x < new_box.x) ? old_box.x : new_box.x;
+	const uint16_t top = (old_box.y < new_box.y) ? old_box.y : new_box.y;
+	const uint16_t right = (old_box.x + old_box.width > new_box.x + new_box.width)
+				   ? (uint16_t)(old_box.x + old_box.width)
+				   : (uint16_t)(new_box.x + new_box.width);
+	const uint16_t bottom = (old_box.y + old_box.height > new_box.y + new_box.height)
+				    ? (uint16_t)(old_box.y + old_box.height)
+				    : (uint16_t)(new_box.y + new_box.height);
+	const lcd_ui_rect_t both = {left, top, (uint16_t)(right - left), (uint16_t)(bottom - top)};
+
+	if ((uint32_t)both.width * both.height <=
+	    (uint32_t)old_box.width * old_box.height + (uint32_t)new_box.width * new_box.height)
+	{
+		repair(ctx, widget, &both, &saved_clip);
+	}
+	else
+	{
+		repair(ctx, widget, &old_box, &saved_clip);
+		repair(ctx, widget, &new_box, &saved_clip);
+	}
+}
+
+void lcd_ui_gauge_draw(lcd_ui_context_t *ctx,
+		       const lcd_ui_widget_t *widget,
+		       uint32_t background, uint32_t foreground)
+{
+	if (!ctx || !widget)
+		return;
+
+	lcd_ui_gauge_t *gauge = (lcd_ui_gauge_t *)widget->data;
+
+	if (!gauge)
+	{
+		lcd_ui_fill_rect(ctx, widget->x, widget->y, widget->width, widget->height, background);
+		return;
+	}
+
+	const lcd_ui_style_t *style = lcd_ui_get_widget_style(ctx, widget);
+
+	if (gauge->face_cached)
+		(void)lcd_ui_surface_draw(ctx, &gauge->face, widget);
+	else
+		render_face(ctx, widget, gauge);
+
+	draw_needle(ctx, widget, gauge, style ? style->shades.accent : lighten_colour(foreground, 40U));
+}
@@ -0,0 +1,414 @@
+/**
+ * @file        lcd_ui_image.c
+ * @brief       Raw and compressed image drawing with streaming decode.
+ *
+ * @author      Ryan Hicks <c3361231@uon.edu.au>
+ *              School of Engineering (Electrical and Computer Engineering)
+ *              University of Newcastle
+ *
+ * @date        2025-04-11
+ * @version     1.0.0
+ *
+ * @copyright   Copyright (c) 2025 Ryan
+ * @license     SPDX-License-Identifier: MIT
+ *
+ * @note        Redistribution and use permitted with attribution.
+ */
+
+#include "lcd_ui_image.h"
+
+#include <string.h>
+
+#define QOI_HEADER_SIZE 14U
+
+/**
+ * @brief Receives decoded pixels in raster order and blits the visible
+ *        ones a strip of rows at a time.
+ */
+typedef struct
+{
+	lcd_ui_context_t *ctx;
+	uint16_t screen_x; /* where image pixel (0, 0) lands */
+	uint16_t screen_y;
+	uint16_t width;    /* image width */
+	uint16_t left;     /* visible image columns [left, right) */
+	uint16_t right;
+	uint16_t top;      /* visible image rows [top, bottom) */
+	uint16_t bottom;
+	uint16_t row;      /* position of the next pixel */
+	uint16_t column;
+	uint16_t strip_top;  /* image row held in the first strip row */
+	uint16_t strip_rows; /* rows the strip holds */
+	uint32_t strip[LCD_UI_IMAGE_STRIP];
+} sink_t;
+
+/**
+ * @brief Blits the strip rows filled so far.
+ */
+static void sink_flush(sink_t *sink)
+{
+	const uint16_t band = sink->right - sink->left;
+
+	if (sink->row > sink->strip_top)
+	{
+		lcd_ui_draw_bitmap(sink->ctx,
+				   sink->screen_x + sink->left, sink->screen_y + sink->strip_top,
+				   band, sink->row - sink->strip_top,
+				   sink->strip, band);
+	}
+	sink->strip_top = sink->row;
+}
+
+/**
+ * @brief Takes @p count pixels of one colour.
+ * @return 0 once the rows below the visible area are reached.
+ */
+static uint8_t sink_run(sink_t *sink, uint32_t colour, uint32_t count)
+{
+	while (count != 0U)
+	{
+		uint32_t n = (uint32_t)(sink->width - sink->column);
+		if (n > count)
+			n = count;
+
+		if (sink->row >= sink->top)
+		{
+			const uint32_t from = (sink->column > sink->left) ? sink->column : sink->left;
+			const uint32_t to = (sink->column + n < sink->right) ? (sink->column + n) : sink->right;
+			uint32_t *out = sink->strip +
+					(size_t)(sink->row - sink->strip_top) * (sink->right - sink->left) -
+					sink->left;
+
+			for (uint32_t c = from; c < to; ++c)
+			{
+				out[c] = colour;
+			}
+		}
+
+		sink->column = (uint16_t)(sink->column + n);
+		count -= n;
+
+		if (sink->column == sink->width)
+		{
+			sink->column = 0U;
+			++sink->row;
+
+			if (sink->row <= sink->top)
+			{
+				sink->strip_top = sink->row;
+			}
+			else if ((sink->row - sink->strip_top == sink->strip_rows) ||
+				 (sink->row == sink->bottom))
+			{
+				sink_flush(sink);
+			}
+
+			if (sink->row >= sink->bottom)
+				return 0U;
+		}
+	}
+
+	return 1U;
+}
+
+static uint32_t rgb565_at(const uint8_t *bytes)
+{
+	return rgb565_to_argb((uint16_t)(bytes[0] | (bytes[1] << 8)));
+}
+
+/**
+ * @brief Streams RLE565 packets from byte @p position into the sink.
+ */
+static void decode_rle(const lcd_ui_image_t *image, sink_t *sink, uint32_t position)
+{
+	const uint8_t *data = (const uint8_t *)image->data;
+
+	while (position < image->size)
+	{
+		const uint8_t header = data[position++];
+		const uint32_t count = (uint32_t)(header & 0x7FU) + 1U;
+
+		if (header & 0x80U)
+		{
+			if (position + 2U > image->size)
+				return;
+			if (!sink_run(sink, rgb565_at(data + position), count))
+				return;
+			position += 2U;
+		}
+		else
+		{
+			if (position + 2U * count > image->size)
+				return;
+			for (uint32_t i = 0U; i < count; ++i, position += 2U)
+			{
+				if (!sink_run(sink, rgb565_at(data + position), 1U))
+					return;
+			}
+		}
+	}
+}
+
+/**
+ * @brief Streams QOI chunks from byte @p position into the sink,
+ *        resetting the decoder at restart rows.
+ */
+static void decode_qoi(const lcd_ui_image_t *image, sink_t *sink, uint32_t position,
+		       uint32_t background)
+{
+	const uint8_t *data = (const uint8_t *)image->data;
+	uint8_t index[64][4];
+	uint8_t px[4] = {0U, 0U, 0U, 255U};
+	uint32_t next_restart = sink->row;
+
+	/* Only the pixel data; the end marker is 8 bytes */
+	const uint32_t end = (image->size > 8U) ? (image->size - 8U) : 0U;
+
+	while (position < end)
+	{
+		uint32_t count = 1U;
+
+		if ((image->restart_interval != 0U) && (sink->column == 0U) &&
+		    (sink->row == next_restart))
+		{
+			memset(index, 0, sizeof(index));
+			px[0] = px[1] = px[2] = 0U;
+			px[3] = 255U;
+			next_restart += image->restart_interval;
+		}
+		else if (sink->row == next_restart)
+		{
+			/* No restarts: the table starts empty once, at the top */
+			memset(index, 0, sizeof(index));
+			next_restart = UINT32_MAX;
+		}
+
+		const uint8_t op = data[position++];
+
+		if (op == 0xFEU)
+		{
+			if (position + 3U > end)
+				return;
+			px[0] = data[position];
+			px[1] = data[position + 1U];
+			px[2] = data[position + 2U];
+			position += 3U;
+		}
+		else if (op == 0xFFU)
+		{
+			if (position + 4U > end)
+				return;
+			memcpy(px, data + position, 4U);
+			position += 4U;
+		}
+		else
+		{
+			switch (op >> 6)
+			{
+			case 0U: /* index */
+				memcpy(px, index[op & 0x3FU], 4U);
+				break;
+			case 1U: /* small difference */
+				px[0] = (uint8_t)(px[0] + ((op >> 4) & 0x03U) - 2U);
+				px[1] = (uint8_t)(px[1] + ((op >> 2) & 0x03U) - 2U);
+				px[2] = (uint8_t)(px[2] + (op & 0x03U) - 2U);
+				break;
+			case 2U: /* luma difference */
+			{
+				if (position >= end)
+					return;
+				const uint8_t second = data[position++];
+				const int32_t green = (int32_t)(op & 0x3FU) - 32;
+				px[0] = (uint8_t)(px[0] + green - 8 + ((second >> 4) & 0x0F));
+				px[1] = (uint8_t)(px[1] + green);
+				px[2] = (uint8_t)(px[2] + green - 8 + (second & 0x0F));
+				break;
+			}
+			default: /* run */
+				count = (uint32_t)(op & 0x3FU) + 1U;
+				break;
+			}
+		}
+
+		memcpy(index[(px[0] * 3U + px[1] * 5U + px[2] * 7U + px[3] * 11U) % 64U], px, 4U);
+
+		uint32_t colour = make_argb_colour(255U, px[0], px[1], px[2]);
+		if (px[3] != 255U)
+			colour = blend_colours(colour, background, px[3]);
+
+		if (!sink_run(sink, colour, count))
+			return;
+	}
+}
+
+/**
+ * @brief Decodes the visible part of a compressed image, one column band
+ *        of at most LCD_UI_IMAGE_STRIP pixels per pass.
+ */
+static void draw_compressed(lcd_ui_context_t *ctx, const lcd_ui_image_t *image,
+			    uint16_t x, uint16_t y, const lcd_ui_rect_t *visible,
+			    uint32_t background)
+{
+	sink_t sink;
+	uint16_t start_row = 0U;
+	uint32_t position = (image->format == LCD_UI_IMAGE_QOI) ? QOI_HEADER_SIZE : 0U;
+
+	/* Start at the last restart at or above the first visible row */
+	if (image->row_index && (image->restart_interval != 0U))
+	{
+		const uint16_t restart = (visible->y - y) / image->restart_interval;
+		start_row = restart * image->restart_interval;
+		position = image->row_index[restart];
+	}
+
+	sink.ctx = ctx;
+	sink.screen_x = x;
+	sink.screen_y = y;
+	sink.width = image->width;
+	sink.top = visible->y - y;
+	sink.bottom = sink.top + visible->height;
+
+	const uint16_t band_end = (uint16_t)(visible->x + visible->width - x);
+
+	for (uint16_t band = (uint16_t)(visible->x - x); band < band_end; band += LCD_UI_IMAGE_STRIP)
+	{
+		sink.left = band;
+		sink.right = ((uint16_t)(band_end - band) > LCD_UI_IMAGE_STRIP)
+				     ? (uint16_t)(band + LCD_UI_IMAGE_STRIP)
+				     : band_end;
+		sink.strip_rows = (uint16_t)(LCD_UI_IMAGE_STRIP / (sink.right - sink.left));
+		sink.row = start_row;
+		sink.column = 0U;
+		sink.strip_top = (start_row > sink.top) ? start_row : sink.top;
+
+		if (image->format == LCD_UI_IMAGE_QOI)
+			decode_qoi(image, &sink, position, background);
+		else
+			decode_rle(image, &sink, position);
+
+		/* Truncated data: show what was decoded */
+		if (sink.row < sink.bottom)
+			sink_flush(&sink);
+	}
+}
+
+uint8_t lcd_ui_image_init_qoi(lcd_ui_image_t *image, const void *data, uint32_t size)
+{
+	const uint8_t *bytes = (const uint8_t *)data;
+
+	if (!image || !bytes || (size < QOI_HEADER_SIZE + 8U) || (memcmp(bytes, "qoif", 4U) != 0))
+		return 0U;
+
+	const uint32_t width = ((uint32_t)bytes[4] << 24) | ((uint32_t)bytes[5] << 16) |
+			       ((uint32_t)bytes[6] << 8) | bytes[7];
+	const uint32_t height = ((uint32_t)bytes[8] << 24) | ((uint32_t)bytes[9] << 16) |
+				((uint32_t)bytes[10] << 8) | bytes[11];
+
+	if ((width == 0U) || (height == 0U) || (width > UINT16_MAX) || (height > UINT16_MAX))
+		return 0U;
+
+	memset(image, 0, sizeof(*image));
+	image->data = data;
+	image->size = size;
+	image->width = (uint16_t)width;
+	image->height = (uint16_t)height;
+	image->format = LCD_UI_IMAGE_QOI;
+	return 1U;
+}
+
+void lcd_ui_image_draw_at(lcd_ui_context_t *ctx, const lcd_ui_image_t *image,
+			  uint16_t x, uint16_t y, uint32_t background)
+{
+	if (!ctx || !image || !image->data)
+		return;
+
+	/* Visible part of the image, in logical coordinates */
+	lcd_ui_rect_t visible = {x, y, image->width, image->height};
+	const uint32_t right = ((uint32_t)x + image->width < (uint32_t)ctx->clip.x + ctx->clip.width)
+				   ? ((uint32_t)x + image->width)
+				   : ((uint32_t)ctx->clip.x + ctx->clip.width);
+	const uint32_t bottom = ((uint32_t)y + image->height < (uint32_t)ctx->clip.y + ctx->clip.height)
+				    ? ((uint32_t)y + image->height)
+				    : ((uint32_t)ctx->clip.y + ctx->clip.height);
+
+	if (visible.x < ctx->clip.x)
+		visible.x = ctx->clip.x;
+	if (visible.y < ctx->clip.y)
+		visible.y = ctx->clip.y;
+	if ((right <= visible.x) || (bottom <= visible.y))
+		return;
+	visible.width = (uint16_t)(right - visible.x);
+	visible.height = (uint16_t)(bottom - visible.y);
+
+	switch (image->format)
+	{
+	case LCD_UI_IMAGE_ARGB8888:
+		if (image->size >= (uint32_t)image->width * image->height * 4U)
+		{
+			lcd_ui_draw_bitmap(ctx, x, y, image->width, image->height,
+					   (const uint32_t *)image->data, image->width);
+		}
+		break;
+
+	case LCD_UI_IMAGE_RGB565:
+		if (image->size >= (uint32_t)image->width * image->height * 2U)
+		{
+			lcd_ui_draw_rgb565(ctx, x, y, image->width, image->height,
+					   (const uint16_t *)image->data, image->width);
+		}
+		break;
+
+	case LCD_UI_IMAGE_RLE565:
+	case LCD_UI_IMAGE_QOI:
+		draw_compressed(ctx, image, x, y, &visible, background);
+		break;
+
+	default:
+		break;
+	}
+}
+
+void lcd_ui_image_draw(lcd_ui_context_t *ctx,
+		       const lcd_ui_widget_t *widget,
+		       uint32_t background)
+{
+	if (!ctx || !widget)
+		return;
+
+	const lcd_ui_image_t *image = (const lcd_ui_image_t *)widget->data;
+	const uint16_t image_w = image ? ((image->width < widget->width) ? image->width : widget->width) : 0U;
+	const uint16_t image_h = image ? ((image->height < widget->height) ? image->height : widget->height) : 0U;
+
+	/* Background only where the image does not reach */
+	if (image_w < widget->width)
+		lcd_ui_fill_rect(ctx, widget->x + image_w, widget->y,
+				 widget->width - image_w, widget->height, background);
+	if (image_h < widget->height)
+		lcd_ui_fill_rect(ctx, widget->x, widget->y + image_h,
+				 image_w, widget->height - image_h, background);
+
+	if ((image_w == 0U) || (image_h == 0U))
+		return;
+
+	/* Images larger than the widget are cropped to it */
+	const lcd_ui_rect_t saved_clip = ctx->clip;
+	const uint32_t right = ((uint32_t)widget->x + image_w < (uint32_t)saved_clip.x + saved_clip.width)
+				   ? ((uint32_t)widget->x + image_w)
+				   : ((uint32_t)saved_clip.x + saved_clip.width);
+	const uint32_t bottom = ((uint32_t)widget->y + image_h < (uint32_t)saved_clip.y + saved_clip.height)
+				    ? ((uint32_t)widget->y + image_h)
+				    : ((uint32_t)saved_clip.y + saved_clip.height);
+
+	if (ctx->clip.x < widget->x)
+		ctx->clip.x = widget->x;
+	if (ctx->clip.y < widget->y)
+		ctx->clip.y = widget->y;
+	if ((right > ctx->clip.x) && (bottom > ctx->clip.y))
+	{
+		ctx->clip.width = (uint16_t)(right - ctx->clip.x);
+		ctx->clip.height = (uint16_t)(bottom - ctx->clip.y);
+		lcd_ui_image_draw_at(ctx, image, widget->x, widget->y, background);
+	}
+
+	ctx->clip = saved_clip;
+}
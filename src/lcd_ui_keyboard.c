@@ -0,0 +1,398 @@
+/**
+ * @file        lcd_ui_keyboard.c
+ * @brief       On-screen keyboard widget with cached layouts.
+ *
+ * @author      Ryan Hicks <c3361231@uon.edu.au>
+ *              School of Engineering (Electrical and Computer Engineering)
+ *              University of Newcastle
+ *
+ * @date        2025-04-11
+ * @version     1.0.0
+ *
+ * @copyright   Copyright (c) 2025 Ryan
+ * @license     SPDX-License-Identifier: MIT
+ *
+ * @note        Redistribution and use permitted with attribution.
+ */
+
+#include "lcd_ui_keyboard.h"
+#include "lcd_ui_colours.h"
+
+#include <string.h>
+
+static const lcd_ui_keyboard_layout_t *current_layout(const lcd_ui_keyboard_t *keyboard)
+{
+	return &keyboard->layouts[keyboard->layout];
+}
+
+/**
+ * @brief First and one-past-last column of the key covering @p column.
+ */
+static void key_span(const lcd_ui_keyboard_layout_t *layout, uint8_t row, uint8_t column,
+		     uint8_t *first, uint8_t *last)
+{
+	const char *codes = layout->rows[row];
+
+	*first = column;
+	while ((*first > 0U) && (codes[*first - 1U] == codes[column]))
+		--*first;
+
+	*last = (uint8_t)(column + 1U);
+	while ((*last < layout->columns) && (codes[*last] == codes[column]))
+		++*last;
+}
+
+/**
+ * @brief Cells of the key from @p first to @p last in @p row.
+ */
+static lcd_ui_rect_t key_rect(const lcd_ui_widget_t *widget,
+			      const lcd_ui_keyboard_layout_t *layout,
+			      uint8_t row, uint8_t first, uint8_t last)
+{
+	const uint16_t key_w = widget->width / layout->columns;
+	const uint16_t key_h = widget->height / layout->row_count;
+	lcd_ui_rect_t rect;
+
+	rect.x = (uint16_t)(widget->x + first * key_w);
+	rect.y = (uint16_t)(widget->y + row * key_h);
+	rect.width = (uint16_t)((last - first) * key_w);
+	rect.height = key_h;
+	return rect;
+}
+
+/**
+ * @brief Text shown on a key, or NULL for none.
+ */
+static const char *key_label(const lcd_ui_keyboard_t *keyboard, char code, char *single)
+{
+	if (code == LCD_UI_KEY_BACKSPACE)
+		return "DEL";
+	if (code == LCD_UI_KEY_ENTER)
+		return "OK";
+	if ((code >= LCD_UI_KEY_LAYOUT(0)) &&
+	    (code < LCD_UI_KEY_LAYOUT(keyboard->layout_count)))
+		return keyboard->layouts[code - LCD_UI_KEY_LAYOUT(0)].name;
+	if ((code <= ' ') || (code > '~'))
+		return NULL;
+
+	single[0] = code;
+	single[1] = '\0';
+	return single;
+}
+
+/**
+ * @brief Draws one key, inset a pixel from its cells, in @p face.
+ */
+static void draw_key(lcd_ui_context_t *ctx, const lcd_ui_widget_t *widget,
+		     const lcd_ui_keyboard_t *keyboard, uint8_t row, uint8_t column,
+		     uint32_t face, uint32_t text_colour)
+{
+	const lcd_ui_keyboard_layout_t *layout = current_layout(keyboard);
+	uint8_t first;
+	uint8_t last;
+	char single[2];
+
+	key_span(layout, row, column, &first, &last);
+
+	const lcd_ui_rect_t cells = key_rect(widget, layout, row, first, last);
+	const char *label = key_label(keyboard, layout->rows[row][column], single);
+
+	if ((cells.width < 3U) || (cells.height < 3U))
+		return;
+
+	lcd_ui_fill_rect(ctx, cells.x + 1U, cells.y + 1U, cells.width - 2U, cells.height - 2U, face);
+
+	if (label)
+	{
+		const uint16_t font_w = ctx->driver->get_font_width(ctx->driver_instance);
+		const uint16_t font_h = ctx->driver->get_font_height(ctx->driver_instance);
+		const uint16_t text_w = (uint16_t)(strlen(label) * font_w);
+
+		if ((text_w + 2U <= cells.width) && (font_h + 2U <= cells.height))
+		{
+			lcd_ui_draw_text(ctx, (uint16_t)(cells.x + (cells.width - text_w) / 2U),
+					 (uint16_t)(cells.y + (cells.height - font_h) / 2U),
+					 label, text_colour, face);
+		}
+	}
+}
+
+/**
+ * @brief Draws the idle layout: background and every key, each label
+ *        rasterised once. Rendered into the layout's surface when the
+ *        keyboard has a cache.
+ */
+static void render_face(lcd_ui_context_t *ctx, const lcd_ui_widget_t *widget, void *user_data)
+{
+	const lcd_ui_keyboard_t *keyboard = (const lcd_ui_keyboard_t *)user_data;
+	const lcd_ui_keyboard_layout_t *layout = current_layout(keyboard);
+	const lcd_ui_style_t *style = lcd_ui_get_widget_style(ctx, widget);
+	const uint16_t key_h = widget->height / layout->row_count;
+	uint32_t background = 0U;
+	uint32_t foreground = 0U;
+
+	lcd_ui_get_widget_colours(ctx, widget, &background, &foreground);
+	const uint32_t face = style ? style->shades.focused : lighten_colour(background, 20U);
+
+	lcd_ui_fill_rect(ctx, widget->x, widget->y, widget->width, widget->height, background);
+
+	for (uint8_t row = 0U; row < layout->row_count; ++row)
+	{
+		const int32_t top = widget->y + row * key_h;
+
+		/* Rows outside the clip draw nothing */
+		if ((top >= ctx->clip.y + ctx->clip.height) || (top + key_h <= ctx->clip.y))
+			continue;
+
+		for (uint8_t column = 0U; column < layout->columns;)
+		{
+			uint8_t first;
+			uint8_t last;
+
+			key_span(layout, row, column, &first, &last);
+			if (layout->rows[row][column] != LCD_UI_KEY_GAP)
+				draw_key(ctx, widget, keyboard, row, column, face, foreground);
+			column = last;
+		}
+	}
+}
+
+/**
+ * @brief Repaints the cells of one key through the widget, so only that
+ *        key is drawn and anything above stays on top.
+ */
+static void repaint_key(lcd_ui_context_t *ctx, lcd_ui_widget_t *widget,
+			uint8_t row, uint8_t column)
+{
+	const lcd_ui_keyboard_t *keyboard = (const lcd_ui_keyboard_t *)widget->data;
+	const lcd_ui_keyboard_layout_t *layout = current_layout(keyboard);
+	const lcd_ui_rect_t saved_clip = ctx->clip;
+	uint8_t first;
+	uint8_t last;
+
+	key_span(layout, row, column, &first, &last);
+
+	const lcd_ui_rect_t cells = key_rect(widget, layout, row, first, last);
+	const uint16_t left = (cells.x > saved_clip.x) ? cells.x : saved_clip.x;
+	const uint16_t top = (cells.y > saved_clip.y) ? cells.y : saved_clip.y;
+	const uint32_t right = ((uint32_t)cells.x + cells.width < (uint32_t)saved_clip.x + saved_clip.width)
+				   ? ((uint32_t)cells.x + cells.width)
+				   : ((uint32_t)saved_clip.x + saved_clip.width);
+	const uint32_t bottom = ((uint32_t)cells.y + cells.height < (uint32_t)saved_clip.y + saved_clip.height)
+				    ? ((uint32_t)cells.y + cells.height)
+				    : ((uint32_t)saved_clip.y + saved_clip.height);
+
+	if ((right <= left) || (bottom <= top))
+		return;
+
+	ctx->clip.x = left;
+	ctx->clip.y = top;
+	ctx->clip.width = (uint16_t)(right - left);
+	ctx->clip.height = (uint16_t)(bottom - top);
+	lcd_ui_redraw_widget(ctx, widget);
+	ctx->clip = saved_clip;
+}
+
+/**
+ * @brief Applies a typed key to the text buffer and the layout.
+ */
+static void type_key(lcd_ui_context_t *ctx, lcd_ui_widget_t *widget, char code)
+{
+	lcd_ui_keyboard_t *keyboard = (lcd_ui_keyboard_t *)widget->data;
+
+	if ((code >= LCD_UI_KEY_LAYOUT(0)) &&
+	    (code < LCD_UI_KEY_LAYOUT(keyboard->layout_count)))
+	{
+		lcd_ui_keyboard_set_layout(ctx, widget, (uint8_t)(code - LCD_UI_KEY_LAYOUT(0)));
+		return;
+	}
+
+	if (!keyboard->text || (keyboard->text_size == 0U))
+		return;
+
+	if (code == LCD_UI_KEY_BACKSPACE)
+	{
+		if (keyboard->length > 0U)
+			keyboard->text[--keyboard->length] = '\0';
+	}
+	else if ((code >= ' ') && (code <= '~') && (keyboard->length + 1U < keyboard->text_size))
+	{
+		keyboard->text[keyboard->length++] = code;
+		keyboard->text[keyboard->length] = '\0';
+	}
+}
+
+void lcd_ui_keyboard_init(lcd_ui_keyboard_t *keyboard,
+			  lcd_ui_surface_cache_t *cache,
+			  const lcd_ui_keyboard_layout_t *layouts,
+			  uint8_t layout_count,
+			  char *text, size_t text_size)
+{
+	if (!keyboard)
+		return;
+
+	if (layout_count > LCD_UI_KEYBOARD_MAX_LAYOUTS)
+		layout_count = LCD_UI_KEYBOARD_MAX_LAYOUTS;
+
+	keyboard->layouts = layouts;
+	keyboard->layout_count = layouts ? layout_count : 0U;
+	keyboard->layout = 0U;
+	keyboard->text = text;
+	keyboard->text_size = text_size;
+	keyboard->length = 0U;
+	keyboard->faces_cached = (cache != NULL);
+	keyboard->pressed = 0U;
+	keyboard->key = 0;
+
+	if (text && (text_size > 0U))
+		text[0] = '\0';
+
+	if (cache)
+	{
+		for (uint8_t i = 0U; i < keyboard->layout_count; ++i)
+			lcd_ui_surface_init(cache, &keyboard->faces[i], render_face, keyboard);
+	}
+}
+
+void lcd_ui_keyboard_set_layout(lcd_ui_context_t *ctx, lcd_ui_widget_t *widget,
+				uint8_t layout)
+{
+	if (!ctx || !widget || (widget->type != LCD_UI_WIDGET_KEYBOARD) || !widget->data)
+		return;
+
+	lcd_ui_keyboard_t *keyboard = (lcd_ui_keyboard_t *)widget->data;
+
+	if ((layout >= keyboard->layout_count) || (layout == keyboard->layout))
+		return;
+
+	keyboard->layout = layout;
+	keyboard->pressed = 0U;
+	lcd_ui_redraw_widget(ctx, widget);
+}
+
+char lcd_ui_keyboard_key_at(const lcd_ui_widget_t *widget,
+			    uint16_t x, uint16_t y,
+			    uint8_t *row, uint8_t *column)
+{
+	if (!widget || !widget->data)
+		return 0;
+
+	const lcd_ui_keyboard_t *keyboard = (const lcd_ui_keyboard_t *)widget->data;
+
+	if (keyboard->layout_count == 0U)
+		return 0;
+
+	const lcd_ui_keyboard_layout_t *layout = current_layout(keyboard);
+
+	if ((layout->columns == 0U) || (layout->row_count == 0U) ||
+	    (x < widget->x) || (y < widget->y))
+		return 0;
+
+	const uint16_t key_w = widget->width / layout->columns;
+	const uint16_t key_h = widget->height / layout->row_count;
+
+	if ((key_w == 0U) || (key_h == 0U))
+		return 0;
+
+	const uint16_t r = (uint16_t)((y - widget->y) / key_h);
+	const uint16_t c = (uint16_t)((x - widget->x) / key_w);
+
+	if ((r >= layout->row_count) || (c >= layout->columns))
+		return 0;
+
+	const char code = layout->rows[r][c];
+
+	if (code == LCD_UI_KEY_GAP)
+		return 0;
+
+	if (row)
+		*row = (uint8_t)r;
+	if (column)
+		*column = (uint8_t)c;
+	return code;
+}
+
+void lcd_ui_keyboard_touch(lcd_ui_context_t *ctx, lcd_ui_widget_t *widget,
+			   uint16_t x, uint16_t y, uint8_t phase)
+{
+	if (!ctx || !widget || !widget->data)
+		return;
+
+	lcd_ui_keyboard_t *keyboard = (lcd_ui_keyboard_t *)widget->data;
+	const uint8_t was_pressed = keyboard->pressed;
+	const uint8_t old_row = keyboard->pressed_row;
+	const uint8_t old_column = keyboard->pressed_column;
+
+	if (phase == 0U)
+	{
+		if (!was_pressed)
+			return;
+
+		const char code = current_layout(keyboard)->rows[old_row][old_column];
+
+		keyboard->pressed = 0U;
+		keyboard->key = code;
+		repaint_key(ctx, widget, old_row, old_column);
+		type_key(ctx, widget, code);
+
+		if (widget->on_touch)
+		{
+			widget->on_touch(ctx, widget, x, y, widget->user_data);
+		}
+		return;
+	}
+
+	uint8_t row = 0U;
+	uint8_t column = 0U;
+	const char code = lcd_ui_keyboard_key_at(widget, x, y, &row, &column);
+
+	/* Sliding within one key changes nothing */
+	if (was_pressed && code && (row == old_row))
+	{
+		uint8_t first;
+		uint8_t last;
+
+		key_span(current_layout(keyboard), row, old_column, &first, &last);
+		if ((column >= first) && (column < last))
+			return;
+	}
+
+	keyboard->pressed = (code != 0);
+	keyboard->pressed_row = row;
+	keyboard->pressed_column = column;
+
+	if (was_pressed)
+		repaint_key(ctx, widget, old_row, old_column);
+	if (keyboard->pressed)
+		repaint_key(ctx, widget, row, column);
+}
+
+void lcd_ui_keyboard_draw(lcd_ui_context_t *ctx,
+			  const lcd_ui_widget_t *widget,
+			  uint32_t background, uint32_t foreground)
+{
+	if (!ctx || !widget)
+		return;
+
+	lcd_ui_keyboard_t *keyboard = (lcd_ui_keyboard_t *)widget->data;
+
+	if (!keyboard || (keyboard->layout_count == 0U) ||
+	    (current_layout(keyboard)->columns == 0U) || (current_layout(keyboard)->row_count == 0U))
+	{
+		lcd_ui_fill_rect(ctx, widget->x, widget->y, widget->width, widget->height, background);
+		return;
+	}
+
+	if (keyboard->faces_cached)
+		(void)lcd_ui_surface_draw(ctx, &keyboard->faces[keyboard->layout], widget);
+	else
+		render_face(ctx, widget, keyboard);
+
+	if (keyboard->pressed)
+	{
+		const lcd_ui_style_t *style = lcd_ui_get_widget_style(ctx, widget);
+
+		draw_key(ctx, widget, keyboard, keyboard->pressed_row, keyboard->pressed_column,
+			 style ? style->shades.pressed : darken_colour(background, 20U), foreground);
+	}
+}
@@ -0,0 +1,333 @@
+/**
+ * @file        lcd_ui_list.c
+ * @brief       Virtualised scrolling list widget.
+ *
+ * @author      Ryan Hicks <c3361231@uon.edu.au>
+ *              School of Engineering (Electrical and Computer Engineering)
+ *              University of Newcastle
+ *
+ * @date        2025-04-11
+ * @version     1.0.0
+ *
+ * @copyright   Copyright (c) 2025 Ryan
+ * @license     SPDX-License-Identifier: MIT
+ *
+ * @note        Redistribution and use permitted with attribution.
+ */
+
+#include "lcd_ui_list.h"
+
+/**
+ * @brief Furthest the list can scroll, 0 when it all fits.
+ */
+static uint32_t max_scroll(const lcd_ui_list_t *list, const lcd_ui_widget_t *widget)
+{
+	const uint64_t content = (uint64_t)list->row_count(list->source) * list->row_height;
+
+	return (content > widget->height) ? (uint32_t)(content - widget->height) : 0U;
+}
+
+/**
+ * @brief The pool entry for row @p index, rendered if it is not there yet.
+ */
+static const lcd_ui_list_row_t *materialise(lcd_ui_list_t *list, uint32_t index)
+{
+	lcd_ui_list_row_t *row = &list->pool[index % list->pool_size];
+
+	if (row->index != index)
+	{
+		row->index = index;
+		row->text[0] = '\0';
+		list->render_row(list->source, index, row);
+		row->text[LCD_UI_LIST_TEXT_SIZE - 1U] = '\0';
+	}
+
+	return row;
+}
+
+/**
+ * @brief Redraws the part of row @p index that is on screen.
+ */
+static void redraw_row(lcd_ui_context_t *ctx, lcd_ui_widget_t *widget, uint32_t index)
+{
+	const lcd_ui_list_t *list = (const lcd_ui_list_t *)widget->data;
+	const int64_t top = (int64_t)index * list->row_height - list->scroll;
+
+	if ((top >= widget->height) || (top + list->row_height <= 0))
+		return;
+
+	const lcd_ui_rect_t saved_clip = ctx->clip;
+	lcd_ui_rect_t row = {widget->x, widget->y, widget->width, list->row_height};
+
+	if (top < 0)
+		row.height = (uint16_t)(top + list->row_height);
+	else
+		row.y = (uint16_t)(widget->y + top);
+	if (row.y + row.height > widget->y + widget->height)
+		row.height = widget->y + widget->height - row.y;
+
+	ctx->clip = row;
+	lcd_ui_redraw_widget(ctx, widget);
+	ctx->clip = saved_clip;
+}
+
+void lcd_ui_list_init(lcd_ui_list_t *list,
+		      lcd_ui_list_count_t row_count,
+		      lcd_ui_list_render_t render_row,
+		      void *source,
+		      lcd_ui_list_row_t *pool, uint8_t pool_size,
+		      uint16_t row_height)
+{
+	if (!list)
+		return;
+
+	list->row_count = row_count;
+	list->render_row = render_row;
+	list->source = source;
+	list->pool = pool;
+	list->pool_size = pool ? pool_size : 0U;
+	list->row_height = (row_height > 0U) ? row_height : 1U;
+	list->scroll = 0U;
+	list->selected = LCD_UI_LIST_NO_ROW;
+	list->touch_scroll = 0U;
+	list->touch_y = 0U;
+	list->dragging = 0U;
+
+	for (uint8_t i = 0U; i < list->pool_size; ++i)
+	{
+		pool[i].index = LCD_UI_LIST_NO_ROW;
+	}
+}
+
+void lcd_ui_list_scroll_to(lcd_ui_context_t *ctx, lcd_ui_widget_t *widget,
+			   uint32_t offset)
+{
+	if (!ctx || !widget || (widget->type != LCD_UI_WIDGET_LIST) || !widget->data)
+		return;
+
+	lcd_ui_list_t *list = (lcd_ui_list_t *)widget->data;
+	const uint32_t limit = max_scroll(list, widget);
+
+	if (offset > limit)
+		offset = limit;
+	if (offset == list->scroll)
+		return;
+
+	const uint32_t distance = (offset > list->scroll) ? (offset - list->scroll)
+							  : (list->scroll - offset);
+	const uint8_t down = (offset > list->scroll);
+
+	list->scroll = offset;
+
+	if (distance >= widget->height)
+	{
+		lcd_ui_redraw_widget(ctx, widget);
+	}
+	else
+	{
+		/* The rows entering the view are drawn through lcd_ui_list_draw() */
+		const lcd_ui_rect_t view = {widget->x, widget->y, widget->width, widget->height};
+		uint32_t background = 0U;
+
+		lcd_ui_get_widget_colours(ctx, widget, &background, NULL);
+		lcd_ui_scroll_region(ctx, &view, 0,
+				     down ? (int16_t)-(int16_t)distance : (int16_t)distance,
+				     background);
+	}
+}
+
+uint32_t lcd_ui_list_row_at(const lcd_ui_widget_t *widget, uint16_t y)
+{
+	if (!widget || (widget->type != LCD_UI_WIDGET_LIST) || !widget->data ||
+	    (y < widget->y) || (y >= widget->y + widget->height))
+		return LCD_UI_LIST_NO_ROW;
+
+	const lcd_ui_list_t *list = (const lcd_ui_list_t *)widget->data;
+	const uint32_t index = (uint32_t)(((uint64_t)list->scroll + (y - widget->y)) / list->row_height);
+
+	return (index < list->row_count(list->source)) ? index : LCD_UI_LIST_NO_ROW;
+}
+
+void lcd_ui_list_refresh_row(lcd_ui_context_t *ctx, lcd_ui_widget_t *widget,
+			     uint32_t index)
+{
+	if (!ctx || !widget || (widget->type != LCD_UI_WIDGET_LIST) || !widget->data)
+		return;
+
+	lcd_ui_list_t *list = (lcd_ui_list_t *)widget->data;
+
+	if ((list->pool_size != 0U) && (list->pool[index % list->pool_size].index == index))
+		list->pool[index % list->pool_size].index = LCD_UI_LIST_NO_ROW;
+
+	redraw_row(ctx, widget, index);
+}
+
+void lcd_ui_list_reload(lcd_ui_context_t *ctx, lcd_ui_widget_t *widget)
+{
+	if (!ctx || !widget || (widget->type != LCD_UI_WIDGET_LIST) || !widget->data)
+		return;
+
+	lcd_ui_list_t *list = (lcd_ui_list_t *)widget->data;
+	const uint32_t count = list->row_count(list->source);
+	const uint32_t limit = max_scroll(list, widget);
+
+	for (uint8_t i = 0U; i < list->pool_size; ++i)
+	{
+		list->pool[i].index = LCD_UI_LIST_NO_ROW;
+	}
+
+	if (list->scroll > limit)
+		list->scroll = limit;
+	if ((list->selected != LCD_UI_LIST_NO_ROW) && (list->selected >= count))
+		list->selected = LCD_UI_LIST_NO_ROW;
+
+	lcd_ui_redraw_widget(ctx, widget);
+}
+
+void lcd_ui_list_touch(lcd_ui_context_t *ctx, lcd_ui_widget_t *widget,
+		       uint16_t x, uint16_t y, uint8_t phase)
+{
+	if (!ctx || !widget || (widget->type != LCD_UI_WIDGET_LIST) || !widget->data)
+		return;
+
+	lcd_ui_list_t *list = (lcd_ui_list_t *)widget->data;
+
+	if (phase == 1U)
+	{
+		list->touch_y = y;
+		list->touch_scroll = list->scroll;
+		list->dragging = 0U;
+		return;
+	}
+
+	const int32_t moved = (int32_t)list->touch_y - (int32_t)y;
+
+	if (phase == 2U)
+	{
+		if (!list->dragging &&
+		    ((moved > (int32_t)LCD_UI_LIST_DRAG_THRESHOLD) ||
+		     (moved < -(int32_t)LCD_UI_LIST_DRAG_THRESHOLD)))
+		{
+			list->dragging = 1U;
+		}
+
+		/* Content follows the finger */
+		if (list->dragging)
+		{
+			const int64_t target = (int64_t)list->touch_scroll + moved;
+			lcd_ui_list_scroll_to(ctx, widget, (target < 0) ? 0U : (uint32_t)target);
+		}
+		return;
+	}
+
+	/* Release: a touch that never dragged is a tap */
+	if (list->dragging)
+	{
+		list->dragging = 0U;
+		return;
+	}
+
+	const uint32_t index = lcd_ui_list_row_at(widget, y);
+	if (index == LCD_UI_LIST_NO_ROW)
+		return;
+
+	const uint32_t previous = list->selected;
+	list->selected = index;
+
+	if (previous != index)
+	{
+		if (previous != LCD_UI_LIST_NO_ROW)
+			redraw_row(ctx, widget, previous);
+		redraw_row(ctx, widget, index);
+	}
+
+	if (widget->on_touch)
+	{
+		widget->on_touch(ctx, widget, x, y, widget->user_data);
+	}
+}
+
+void lcd_ui_list_draw(lcd_ui_context_t *ctx,
+		      const lcd_ui_widget_t *widget,
+		      uint32_t background, uint32_t foreground)
+{
+	if (!ctx || !widget)
+		return;
+
+	lcd_ui_list_t *list = (lcd_ui_list_t *)widget->data;
+	const lcd_ui_rect_t saved_clip = ctx->clip;
+	const lcd_ui_rect_t saved_scissor = ctx->scissor;
+
+	/* Rows crossing the edges are cut by the widget, text included */
+	uint16_t top = widget->y;
+	uint16_t bottom = widget->y + widget->height;
+	if (top < ctx->clip.y)
+		top = ctx->clip.y;
+	if (bottom > ctx->clip.y + ctx->clip.height)
+		bottom = ctx->clip.y + ctx->clip.height;
+	if (top >= bottom)
+		return;
+
+	if (!list || (list->pool_size == 0U) || !list->row_count || !list->render_row)
+	{
+		lcd_ui_fill_rect(ctx, widget->x, top, widget->width, bottom - top, background);
+		return;
+	}
+
+	ctx->clip.y = top;
+	ctx->clip.height = bottom - top;
+	if (ctx->scissor.y < widget->y)
+	{
+		ctx->scissor.height = (ctx->scissor.y + ctx->scissor.height > widget->y)
+					  ? (uint16_t)(ctx->scissor.y + ctx->scissor.height - widget->y)
+					  : 0U;
+		ctx->scissor.y = widget->y;
+	}
+	if (ctx->scissor.y + ctx->scissor.height > widget->y + widget->height)
+	{
+		ctx->scissor.height = (widget->y + widget->height > ctx->scissor.y)
+					  ? (uint16_t)(widget->y + widget->height - ctx->scissor.y)
+					  : 0U;
+	}
+
+	const lcd_ui_style_t *style = lcd_ui_get_widget_style(ctx, widget);
+	const uint32_t highlight = style ? style->shades.focused : lighten_colour(background, 20U);
+	const uint16_t margin = style ? style->margin : 0U;
+	const uint16_t font_h = ctx->driver->get_font_height(ctx->driver_instance);
+	const uint32_t count = list->row_count(list->source);
+
+	/* Only rows inside the clip, found from the scroll offset */
+	const uint32_t first = (uint32_t)(((uint64_t)list->scroll + (top - widget->y)) / list->row_height);
+	const uint32_t last = (uint32_t)(((uint64_t)list->scroll + (bottom - 1U - widget->y)) / list->row_height);
+
+	for (uint32_t index = first; index <= last; ++index)
+	{
+		const int32_t row_y = (int32_t)((int64_t)index * list->row_height - list->scroll) + widget->y;
+		const uint16_t y0 = (row_y < (int32_t)top) ? top : (uint16_t)row_y;
+		const uint16_t y1 = (row_y + list->row_height > (int32_t)bottom)
+					? bottom
+					: (uint16_t)(row_y + list->row_height);
+
+		if (index >= count)
+		{
+			/* Past the last row */
+			lcd_ui_fill_rect(ctx, widget->x, y0, widget->width, bottom - y0, background);
+			break;
+		}
+
+		const lcd_ui_list_row_t *row = materialise(list, index);
+		const uint32_t fill = (index == list->selected) ? highlight : background;
+
+		lcd_ui_fill_rect(ctx, widget->x, y0, widget->width, y1 - y0, fill);
+
+		if ((row->text[0] != '\0') && (row_y >= 0))
+		{
+			const int32_t text_y = row_y + ((int32_t)list->row_height - font_h) / 2;
+			lcd_ui_draw_text(ctx, widget->x + margin, (text_y > 0) ? (uint16_t)text_y : 0U,
+					 row->text, foreground, fill);
+		}
+	}
+
+	ctx->clip = saved_clip;
+	ctx->scissor = saved_scissor;
+}
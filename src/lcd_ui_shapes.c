@@ -0,0 +1,1090 @@
+/**
+ * @file        lcd_ui_shapes.c
+ * @brief       Lines, circles, arcs and rounded rectangles as span batches.
+ *
+ * @author      Ryan Hicks <c3361231@uon.edu.au>
+ *              School of Engineering (Electrical and Computer Engineering)
+ *              University of Newcastle
+ *
+ * @date        2025-04-11
+ * @version     1.0.0
+ *
+ * @copyright   Copyright (c) 2025 Ryan
+ * @license     SPDX-License-Identifier: MIT
+ *
+ * @note        Redistribution and use permitted with attribution.
+ */
+
+#include "lcd_ui_shapes.h"
+
+/**
+ * @brief Pixels cut from the edge of each corner row, top row first,
+ *        for radius 1 at offset 0, radius 2 at offset 1, radius r at
+ *        r * (r - 1) / 2. Same rounding as the circles below.
+ */
+static const uint8_t corner_insets[LCD_UI_CORNER_TABLE_RADIUS * (LCD_UI_CORNER_TABLE_RADIUS + 1U) / 2U] = {
+	0,
+	1, 0,
+	2, 1, 0,
+	2, 1, 0, 0,
+	3, 2, 1, 0, 0,
+	4, 2, 1, 1, 0, 0,
+	5, 3, 2, 1, 1, 0, 0,
+	6, 4, 2, 2, 1, 1, 0, 0,
+	6, 4, 3, 2, 1, 1, 0, 0, 0,
+	7, 5, 4, 3, 2, 1, 1, 0, 0, 0,
+	8, 6, 4, 3, 2, 2, 1, 1, 0, 0, 0,
+	9, 7, 5, 4, 3, 2, 2, 1, 1, 0, 0, 0,
+	10, 7, 6, 4, 3, 3, 2, 1, 1, 1, 0, 0, 0,
+	11, 8, 6, 5, 4, 3, 2, 2, 1, 1, 1, 0, 0, 0,
+	12, 9, 7, 6, 5, 4, 3, 2, 2, 1, 1, 1, 0, 0, 0,
+	12, 10, 8, 6, 5, 4, 3, 3, 2, 2, 1, 1, 0, 0, 0, 0,
+};
+
+/**
+ * @brief Spans waiting to be filled, all in one colour.
+ */
+typedef struct
+{
+	lcd_ui_context_t *ctx;
+	uint32_t colour;
+	int32_t left; /* ctx->clip, inclusive */
+	int32_t top;
+	int32_t right;
+	int32_t bottom;
+	uint16_t count;
+	lcd_ui_span_t spans[LCD_UI_SPAN_BATCH];
+} span_batch_t;
+
+/**
+ * @brief Closed interval of pixels on a row.
+ */
+typedef struct
+{
+	int32_t low;
+	int32_t high;
+} interval_t;
+
+static void batch_start(span_batch_t *batch, lcd_ui_context_t *ctx, uint32_t colour)
+{
+	batch->ctx = ctx;
+	batch->colour = colour;
+	batch->left = ctx->clip.x;
+	batch->top = ctx->clip.y;
+	batch->right = (int32_t)ctx->clip.x + ctx->clip.width - 1;
+	batch->bottom = (int32_t)ctx->clip.y + ctx->clip.height - 1;
+	batch->count = 0U;
+}
+
+static void batch_flush(span_batch_t *batch)
+{
+	if (batch->count != 0U)
+	{
+		lcd_ui_fill_spans(batch->ctx, batch->spans, batch->count, batch->colour);
+		batch->count = 0U;
+	}
+}
+
+/**
+ * @brief Queues pixels x0..x1 of row y, dropping what lies outside the
+ *        clip before it takes a slot.
+ */
+static void batch_add(span_batch_t *batch, int32_t x0, int32_t x1, int32_t y)
+{
+	if ((y < batch->top) || (y > batch->bottom))
+		return;
+	if (x0 < batch->left)
+		x0 = batch->left;
+	if (x1 > batch->right)
+		x1 = batch->right;
+	if (x1 < x0)
+		return;
+
+	batch->spans[batch->count].x = (uint16_t)x0;
+	batch->spans[batch->count].y = (uint16_t)y;
+	batch->spans[batch->count].length = (uint16_t)(x1 - x0 + 1);
+
+	if (++batch->count == LCD_UI_SPAN_BATCH)
+		batch_flush(batch);
+}
+
+static uint32_t isqrt(uint32_t value)
+{
+	uint32_t root = 0U;
+	uint32_t bit = 1UL << 30;
+
+	while (bit > value)
+		bit >>= 2;
+
+	while (bit != 0U)
+	{
+		if (value >= root + bit)
+		{
+			value -= root + bit;
+			root = (root >> 1) + bit;
+		}
+		else
+		{
+			root >>= 1;
+		}
+		bit >>= 2;
+	}
+
+	return root;
+}
+
+/**
+ * @brief Half-width of a circle's row @p dy from the centre. Measured
+ *        against radius + 1/2 so the outline is round rather than pointy.
+ */
+static int32_t circle_half(uint32_t radius, int32_t dy)
+{
+	const uint32_t d = (uint32_t)((dy < 0) ? -dy : dy);
+
+	return (int32_t)isqrt(radius * radius + radius - d * d);
+}
+
+/**
+ * @brief Pixels cut from the edge of row @p row (0 at the top) of a
+ *        corner of radius @p radius.
+ */
+static int32_t corner_inset(uint16_t radius, uint16_t row)
+{
+	if (radius <= LCD_UI_CORNER_TABLE_RADIUS)
+		return corner_insets[(uint32_t)radius * (radius - 1U) / 2U + row];
+
+	return (int32_t)radius - circle_half(radius, (int32_t)radius - row);
+}
+
+/**
+ * @brief The rows of a shape spanning y0..y1 that lie inside the clip.
+ * @return 0 if none do.
+ */
+static uint8_t clip_rows(const span_batch_t *batch, int32_t *y0, int32_t *y1)
+{
+	if (*y0 < batch->top)
+		*y0 = batch->top;
+	if (*y1 > batch->bottom)
+		*y1 = batch->bottom;
+	return (*y0 <= *y1);
+}
+
+/**
+ * @brief The pixels of a ring's row: the outer half-width with the inner
+ *        one taken out, always leaving at least one pixel each side so
+ *        thin outlines have no gaps.
+ * @return Number of intervals written to @p out (1 or 2).
+ */
+static uint8_t ring_row(int32_t dy, uint16_t outer, int32_t inner, interval_t out[2])
+{
+	const int32_t d = (dy < 0) ? -dy : dy;
+	const int32_t outer_half = circle_half(outer, dy);
+
+	if ((inner >= 0) && (d <= inner))
+	{
+		int32_t inner_half = circle_half((uint32_t)inner, dy);
+
+		if (inner_half >= outer_half)
+			inner_half = outer_half - 1;
+
+		if (inner_half >= 0)
+		{
+			out[0].low = -outer_half;
+			out[0].high = -inner_half - 1;
+			out[1].low = inner_half + 1;
+			out[1].high = outer_half;
+			return 2U;
+		}
+	}
+
+	out[0].low = -outer_half;
+	out[0].high = outer_half;
+	return 1U;
+}
+
+static int32_t floor_div(int32_t a, int32_t b)
+{
+	return (a >= 0) ? (a / b) : -((-a + b - 1) / b);
+}
+
+/**
+ * @brief Solves c * x + k >= 0 for integer x.
+ * @return 0 if no x does.
+ */
+static uint8_t half_line(int32_t c, int32_t k, interval_t *out)
+{
+	out->low = INT32_MIN;
+	out->high = INT32_MAX;
+
+	if (c == 0)
+		return (k >= 0);
+
+	if (c > 0)
+		out->low = -floor_div(k, c); /* ceil(-k / c) */
+	else
+		out->high = floor_div(k, -c);
+	return 1U;
+}
+
+/**
+ * @brief The pixels of row @p dy inside a sector, as offsets from the
+ *        centre. A point is clockwise of direction (s, c) when
+ *        s * dy + c * dx >= 0; @p bias (Q14 pixels) widens both edges,
+ *        or narrows them when negative.
+ * @return Number of intervals written to @p out (0 to 2).
+ */
+static uint8_t sector_row(int32_t dy, int32_t bias, const int16_t start[2], const int16_t end[2],
+			  uint8_t wide, interval_t out[2])
+{
+	interval_t after;
+	interval_t before;
+	const uint8_t has_after = half_line(start[1], start[0] * dy + bias, &after);
+	const uint8_t has_before = half_line(-end[1], -end[0] * dy + bias, &before);
+
+	if (!wide)
+	{
+		/* Up to half a turn: clockwise of the start and short of the end */
+		if (!has_after || !has_before)
+			return 0U;
+		out[0].low = (after.low > before.low) ? after.low : before.low;
+		out[0].high = (after.high < before.high) ? after.high : before.high;
+		return (out[0].low <= out[0].high) ? 1U : 0U;
+	}
+
+	/* More than half a turn: either condition will do */
+	if (!has_after || !has_before)
+	{
+		out[0] = has_after ? after : before;
+		return (has_after || has_before) ? 1U : 0U;
+	}
+
+	if ((after.low <= (int64_t)before.high + 1) && (before.low <= (int64_t)after.high + 1))
+	{
+		out[0].low = (after.low < before.low) ? after.low : before.low;
+		out[0].high = (after.high > before.high) ? after.high : before.high;
+		return 1U;
+	}
+
+	out[0] = after;
+	out[1] = before;
+	return 2U;
+}
+
+void lcd_ui_draw_line(lcd_ui_context_t *ctx,
+		      int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+		      uint8_t width, uint32_t colour)
+{
+	if (!ctx || !ctx->driver || (width == 0U))
+		return;
+
+	span_batch_t batch;
+	const int32_t dx = (x1 > x0) ? (x1 - x0) : (x0 - x1);
+	const int32_t dy = (y1 > y0) ? (y1 - y0) : (y0 - y1);
+	const int32_t sx = (x1 >= x0) ? 1 : -1;
+	const int32_t sy = (y1 >= y0) ? 1 : -1;
+	const uint8_t x_major = (dx >= dy);
+	const int32_t major = x_major ? dx : dy;
+	const int32_t minor = x_major ? dy : dx;
+	const int32_t half = width / 2;
+	int32_t error = 2 * minor - major;
+	int32_t x = x0;
+	int32_t y = y0;
+	int32_t run_start = x0;
+
+	batch_start(&batch, ctx, colour);
+
+	for (int32_t i = 0; i <= major; ++i)
+	{
+		const uint8_t step = (error > 0);
+
+		if (!x_major)
+		{
+			/* One pixel per row, widened across */
+			batch_add(&batch, x - half, x - half + width - 1, y);
+		}
+		else if (step || (i == major))
+		{
+			/* The run on this row ends here */
+			const int32_t low = (run_start < x) ? run_start : x;
+			const int32_t high = (run_start < x) ? x : run_start;
+
+			for (int32_t row = 0; row < width; ++row)
+				batch_add(&batch, low, high, y - half + row);
+		}
+
+		if (step)
+		{
+			error -= 2 * major;
+			if (x_major)
+			{
+				y += sy;
+				run_start = x + sx;
+			}
+			else
+			{
+				x += sx;
+			}
+		}
+		error += 2 * minor;
+
+		if (x_major)
+			x += sx;
+		else
+			y += sy;
+	}
+
+	batch_flush(&batch);
+}
+
+void lcd_ui_fill_circle(lcd_ui_context_t *ctx,
+			int16_t cx, int16_t cy, uint16_t radius,
+			uint32_t colour)
+{
+	lcd_ui_draw_circle(ctx, cx, cy, radius, (uint16_t)(radius + 1U), colour);
+}
+
+void lcd_ui_draw_circle(lcd_ui_context_t *ctx,
+			int16_t cx, int16_t cy, uint16_t radius,
+			uint16_t thickness, uint32_t colour)
+{
+	if (!ctx || !ctx->driver || (thickness == 0U))
+		return;
+
+	span_batch_t batch;
+	const int32_t inner = (int32_t)radius - thickness;
+	int32_t y0 = cy - (int32_t)radius;
+	int32_t y1 = cy + (int32_t)radius;
+
+	batch_start(&batch, ctx, colour);
+	if (!clip_rows(&batch, &y0, &y1))
+		return;
+
+	for (int32_t y = y0; y <= y1; ++y)
+	{
+		interval_t ring[2];
+		const uint8_t parts = ring_row(y - cy, radius, inner, ring);
+
+		for (uint8_t p = 0U; p < parts; ++p)
+			batch_add(&batch, cx + ring[p].low, cx + ring[p].high, y);
+	}
+
+	batch_flush(&batch);
+}
+
+void lcd_ui_draw_arc(lcd_ui_context_t *ctx,
+		     int16_t cx, int16_t cy, uint16_t radius,
+		     uint16_t thickness,
+		     int16_t start_angle, int16_t sweep,
+		     uint32_t colour)
+{
+	if (!ctx || !ctx->driver || (thickness == 0U) || (sweep == 0))
+		return;
+
+	if ((sweep >= 360) || (sweep <= -360))
+	{
+		lcd_ui_draw_circle(ctx, cx, cy, radius, thickness, colour);
+		return;
+	}
+
+	if (sweep < 0)
+	{
+		start_angle = (int16_t)(start_angle + sweep);
+		sweep = (int16_t)-sweep;
+	}
+
+	span_batch_t batch;
+	const int32_t inner = (int32_t)radius - thickness;
+	const int32_t first = (int32_t)start_angle * (int32_t)LCD_UI_ANGLE_TURN / 360;
+	const int32_t last = (int32_t)(start_angle + sweep) * (int32_t)LCD_UI_ANGLE_TURN / 360;
+	const int16_t start[2] = {lcd_ui_sin((uint16_t)first), lcd_ui_cos((uint16_t)first)};
+	const int16_t end[2] = {lcd_ui_sin((uint16_t)last), lcd_ui_cos((uint16_t)last)};
+	int32_t y0 = cy - (int32_t)radius;
+	int32_t y1 = cy + (int32_t)radius;
+
+	batch_start(&batch, ctx, colour);
+	if (!clip_rows(&batch, &y0, &y1))
+		return;
+
+	for (int32_t y = y0; y <= y1; ++y)
+	{
+		interval_t ring[2];
+		interval_t sector[2];
+		const uint8_t ring_parts = ring_row(y - cy, radius, inner, ring);
+		const uint8_t sector_parts = sector_row(y - cy, 0, start, end, (sweep > 180), sector);
+
+		for (uint8_t r = 0U; r < ring_parts; ++r)
+		{
+			for (uint8_t s = 0U; s < sector_parts; ++s)
+			{
+				const int32_t low = (ring[r].low > sector[s].low) ? ring[r].low : sector[s].low;
+				const int32_t high = (ring[r].high < sector[s].high) ? ring[r].high : sector[s].high;
+
+				if (low <= high)
+					batch_add(&batch, cx + low, cx + high, y);
+			}
+		}
+	}
+
+	batch_flush(&batch);
+}
+
+/**
+ * @brief Largest radius that fits a w x h rectangle.
+ */
+static uint16_t fit_radius(uint16_t radius, uint16_t w, uint16_t h)
+{
+	const uint16_t limit = ((w < h) ? (w - 1U) : (h - 1U)) / 2U;
+
+	return (radius < limit) ? radius : limit;
+}
+
+/**
+ * @brief Pixels cut from either end of row @p row of a rounded
+ *        rectangle @p h rows high.
+ */
+static int32_t round_rect_inset(uint16_t radius, uint16_t h, uint16_t row)
+{
+	if (row < radius)
+		return corner_inset(radius, row);
+	if ((uint16_t)(h - 1U - row) < radius)
+		return corner_inset(radius, (uint16_t)(h - 1U - row));
+	return 0;
+}
+
+void lcd_ui_fill_round_rect(lcd_ui_context_t *ctx,
+			    int16_t x, int16_t y, uint16_t w, uint16_t h,
+			    uint16_t radius, uint32_t colour)
+{
+	if (!ctx || !ctx->driver || (w == 0U) || (h == 0U))
+		return;
+
+	span_batch_t batch;
+	int32_t y0 = y;
+	int32_t y1 = (int32_t)y + h - 1;
+
+	radius = fit_radius(radius, w, h);
+	batch_start(&batch, ctx, colour);
+	if (!clip_rows(&batch, &y0, &y1))
+		return;
+
+	for (int32_t row_y = y0; row_y <= y1; ++row_y)
+	{
+		const int32_t inset = round_rect_inset(radius, h, (uint16_t)(row_y - y));
+		batch_add(&batch, x + inset, (int32_t)x + w - 1 - inset, row_y);
+	}
+
+	batch_flush(&batch);
+}
+
+void lcd_ui_draw_round_rect(lcd_ui_context_t *ctx,
+			    int16_t x, int16_t y, uint16_t w, uint16_t h,
+			    uint16_t radius, uint16_t thickness,
+			    uint32_t colour)
+{
+	if (!ctx || !ctx->driver || (w == 0U) || (h == 0U) || (thickness == 0U))
+		return;
+
+	if ((2U * thickness >= w) || (2U * thickness >= h))
+	{
+		lcd_ui_fill_round_rect(ctx, x, y, w, h, radius, colour);
+		return;
+	}
+
+	/* The inner edge shares the corner centres of the outer one */
+	span_batch_t batch;
+	const uint16_t inner_w = (uint16_t)(w - 2U * thickness);
+	const uint16_t inner_h = (uint16_t)(h - 2U * thickness);
+	const uint16_t outer_radius = fit_radius(radius, w, h);
+	const uint16_t inner_radius = fit_radius((outer_radius > thickness) ? (uint16_t)(outer_radius - thickness) : 0U,
+						 inner_w, inner_h);
+	int32_t y0 = y;
+	int32_t y1 = (int32_t)y + h - 1;
+
+	batch_start(&batch, ctx, colour);
+	if (!clip_rows(&batch, &y0, &y1))
+		return;
+
+	for (int32_t row_y = y0; row_y <= y1; ++row_y)
+	{
+		const uint16_t row = (uint16_t)(row_y - y);
+		const int32_t outer_inset = round_rect_inset(outer_radius, h, row);
+		const int32_t left = x + outer_inset;
+		const int32_t right = (int32_t)x + w - 1 - outer_inset;
+
+		if ((row < thickness) || (row >= thickness + inner_h))
+		{
+			batch_add(&batch, left, right, row_y);
+			continue;
+		}
+
+		const int32_t inner_inset = round_rect_inset(inner_radius, inner_h, (uint16_t)(row - thickness));
+		int32_t inner_left = x + thickness + inner_inset;
+		int32_t inner_right = (int32_t)x + thickness + inner_w - 1 - inner_inset;
+
+		/* Keep at least a pixel each side, as for circles */
+		if (inner_left <= left)
+			inner_left = left + 1;
+		if (inner_right >= right)
+			inner_right = right - 1;
+
+		if (inner_left > inner_right)
+		{
+			batch_add(&batch, left, right, row_y);
+		}
+		else
+		{
+			batch_add(&batch, left, inner_left - 1, row_y);
+			batch_add(&batch, inner_right + 1, right, row_y);
+		}
+	}
+
+	batch_flush(&batch);
+}
+
+/*
+ * Anti-aliased shapes. Each row is split into the pixels the shape
+ * covers completely, which go into a span batch like the shapes above,
+ * and the pixels on its edges, whose coverage is worked out one by one
+ * and blended in batches through lcd_ui_blend_spans(). Lengths are Q8
+ * (1/256 pixel) and coverage runs 0..256 until it is blended.
+ */
+
+/**
+ * @brief Coverage of one edge pixel, 0..255.
+ */
+typedef uint8_t (*coverage_t)(const void *shape, int32_t x, int32_t y);
+
+/**
+ * @brief Solid spans, plus edge spans waiting to be blended with their
+ *        coverage laid end to end.
+ */
+typedef struct
+{
+	span_batch_t batch;
+	uint16_t edge_count;
+	uint16_t covered;
+	lcd_ui_span_t edges[LCD_UI_SPAN_BATCH];
+	uint8_t coverage[4U * LCD_UI_SPAN_BATCH];
+} aa_batch_t;
+
+static void edge_flush(aa_batch_t *aa)
+{
+	if (aa->edge_count != 0U)
+	{
+		lcd_ui_blend_spans(aa->batch.ctx, aa->edges, aa->edge_count, aa->coverage,
+				   aa->batch.colour);
+		aa->edge_count = 0U;
+		aa->covered = 0U;
+	}
+}
+
+/**
+ * @brief Queues one edge pixel, extending the last span when it follows
+ *        on from it. The pixel is already known to be in the clip.
+ */
+static void edge_add(aa_batch_t *aa, int32_t x, int32_t y, uint8_t coverage)
+{
+	lcd_ui_span_t *last = NULL;
+
+	if (aa->covered == sizeof(aa->coverage))
+		edge_flush(aa);
+
+	if (aa->edge_count != 0U)
+		last = &aa->edges[aa->edge_count - 1U];
+
+	if (last && (last->y == y) && (last->x + last->length == x))
+	{
+		++last->length;
+	}
+	else
+	{
+		if (aa->edge_count == LCD_UI_SPAN_BATCH)
+			edge_flush(aa);
+
+		last = &aa->edges[aa->edge_count++];
+		last->x = (uint16_t)x;
+		last->y = (uint16_t)y;
+		last->length = 1U;
+	}
+
+	aa->coverage[aa->covered++] = coverage;
+}
+
+/**
+ * @brief Emits row @p y: pixels in @p any that are also in @p core are
+ *        filled, the rest blended by @p cover. Both sets are sorted and
+ *        in absolute pixels; the row is already known to be in the clip.
+ */
+static void aa_row(aa_batch_t *aa, int32_t y,
+		   const interval_t *any, uint8_t any_count,
+		   const interval_t *core, uint8_t core_count,
+		   coverage_t cover, const void *shape)
+{
+	uint8_t c = 0U;
+
+	for (uint8_t a = 0U; a < any_count; ++a)
+	{
+		int32_t x = (any[a].low > aa->batch.left) ? any[a].low : aa->batch.left;
+		const int32_t high = (any[a].high < aa->batch.right) ? any[a].high : aa->batch.right;
+
+		while (x <= high)
+		{
+			int32_t end = high;
+
+			while ((c < core_count) && (core[c].high < x))
+				++c;
+
+			if ((c < core_count) && (core[c].low <= x))
+			{
+				if (core[c].high < end)
+					end = core[c].high;
+				batch_add(&aa->batch, x, end, y);
+			}
+			else
+			{
+				if ((c < core_count) && (core[c].low - 1 < end))
+					end = core[c].low - 1;
+				for (int32_t px = x; px <= end; ++px)
+					edge_add(aa, px, y, cover(shape, px, y));
+			}
+
+			x = end + 1;
+		}
+	}
+}
+
+static void aa_flush(aa_batch_t *aa)
+{
+	batch_flush(&aa->batch);
+	edge_flush(aa);
+}
+
+static uint32_t isqrt_wide(uint64_t value)
+{
+	uint64_t root = 0U;
+	uint64_t bit = 1ULL << 62;
+
+	while (bit > value)
+		bit >>= 2;
+
+	while (bit != 0U)
+	{
+		if (value >= root + bit)
+		{
+			value -= root + bit;
+			root = (root >> 1) + bit;
+		}
+		else
+		{
+			root >>= 1;
+		}
+		bit >>= 2;
+	}
+
+	return (uint32_t)root;
+}
+
+static int32_t clamp_coverage(int32_t value)
+{
+	return (value < 0) ? 0 : ((value > 256) ? 256 : value);
+}
+
+/**
+ * @brief Combines two 0..256 coverages into one 0..255 weight.
+ */
+static uint8_t coverage_of(int32_t a, int32_t b)
+{
+	return (uint8_t)(((uint32_t)clamp_coverage(a) * (uint32_t)clamp_coverage(b) * 255U + 32768U) >> 16);
+}
+
+static int64_t floor_div_wide(int64_t a, int64_t b)
+{
+	return (a >= 0) ? (a / b) : -((-a + b - 1) / b);
+}
+
+/**
+ * @brief Solves low <= f0 + k * x <= high for integer x, within the
+ *        range of screen coordinates.
+ * @return 0 if no x does.
+ */
+static uint8_t linear_range(int64_t f0, int64_t k, int64_t low, int64_t high, interval_t *out)
+{
+	int64_t first = -65536;
+	int64_t last = 65536;
+
+	if (k == 0)
+	{
+		if ((f0 < low) || (f0 > high))
+			return 0U;
+	}
+	else
+	{
+		if (k < 0)
+		{
+			const int64_t flipped = -low;
+
+			k = -k;
+			f0 = -f0;
+			low = -high;
+			high = flipped;
+		}
+
+		const int64_t from = -floor_div_wide(f0 - low, k); /* ceil((low - f0) / k) */
+		const int64_t to = floor_div_wide(high - f0, k);
+
+		if (from > first)
+			first = from;
+		if (to < last)
+			last = to;
+	}
+
+	out->low = (int32_t)first;
+	out->high = (int32_t)last;
+	return (first <= last);
+}
+
+/**
+ * @brief Pixels in both of two intervals.
+ * @return 1 if they overlap, with the overlap in @p out.
+ */
+static uint8_t intersect_pair(const interval_t *a, const interval_t *b, interval_t *out)
+{
+	out->low = (a->low > b->low) ? a->low : b->low;
+	out->high = (a->high < b->high) ? a->high : b->high;
+	return (out->low <= out->high);
+}
+
+/**
+ * @brief Pixels in both of two sets of intervals, sorted by position.
+ * @return Number of intervals written to @p out, which has room for
+ *         @p a_count * @p b_count.
+ */
+static uint8_t intersect_rows(const interval_t *a, uint8_t a_count,
+			      const interval_t *b, uint8_t b_count,
+			      interval_t *out)
+{
+	uint8_t count = 0U;
+
+	for (uint8_t i = 0U; i < a_count; ++i)
+	{
+		for (uint8_t j = 0U; j < b_count; ++j)
+		{
+			const int32_t low = (a[i].low > b[j].low) ? a[i].low : b[j].low;
+			const int32_t high = (a[i].high < b[j].high) ? a[i].high : b[j].high;
+
+			if (low > high)
+				continue;
+
+			uint8_t at = count++;
+			while ((at > 0U) && (out[at - 1U].low > low))
+			{
+				out[at] = out[at - 1U];
+				--at;
+			}
+			out[at].low = low;
+			out[at].high = high;
+		}
+	}
+
+	return count;
+}
+
+/**
+ * @brief Fraction bits of a stroke's direction. Finer than the Q14 of
+ *        the sine table so long lines stay within a level of coverage.
+ */
+#define STROKE_BITS 20
+
+/**
+ * @brief A straight pen stroke: start point, unit direction and size.
+ */
+typedef struct
+{
+	int32_t ax; /* Q8 */
+	int32_t ay;
+	int32_t ux; /* STROKE_BITS */
+	int32_t uy;
+	int32_t half;   /* Q8 half width */
+	int32_t length; /* Q8 */
+} stroke_t;
+
+/**
+ * @brief Box-filtered coverage: how far the pixel centre lies inside
+ *        the stroke across its width and along its length.
+ */
+static uint8_t stroke_coverage(const void *shape, int32_t x, int32_t y)
+{
+	const stroke_t *stroke = (const stroke_t *)shape;
+	const int64_t rx = (int64_t)x * 256 - stroke->ax;
+	const int64_t ry = (int64_t)y * 256 - stroke->ay;
+	int32_t across = (int32_t)((rx * stroke->uy - ry * stroke->ux) >> STROKE_BITS);
+	int32_t along = (int32_t)((rx * stroke->ux + ry * stroke->uy) >> STROKE_BITS);
+
+	if (across < 0)
+		across = -across;
+	if (stroke->length - along < along)
+		along = stroke->length - along;
+
+	return coverage_of(stroke->half + 128 - across, along + 128);
+}
+
+void lcd_ui_draw_line_aa(lcd_ui_context_t *ctx,
+			 int32_t x0, int32_t y0, int32_t x1, int32_t y1,
+			 uint16_t width, uint32_t colour)
+{
+	if (!ctx || !ctx->driver || (width == 0U))
+		return;
+
+	/* LCD_UI_SUBPIXEL is 1/16 pixel; everything below is Q8 */
+	aa_batch_t aa;
+	stroke_t stroke;
+	const int64_t dx = ((int64_t)x1 - x0) * 16;
+	const int64_t dy = ((int64_t)y1 - y0) * 16;
+	const int32_t top = ((y0 < y1) ? y0 : y1) * 16;
+	const int32_t bottom = ((y0 > y1) ? y0 : y1) * 16;
+
+	const int64_t one = (int64_t)1 << STROKE_BITS;
+
+	stroke.ax = x0 * 16;
+	stroke.ay = y0 * 16;
+	stroke.half = (int32_t)width * 8;
+	stroke.length = (int32_t)isqrt_wide((uint64_t)(dx * dx + dy * dy));
+	stroke.ux = (int32_t)one;
+	stroke.uy = 0;
+	if (stroke.length != 0)
+	{
+		stroke.ux = (int32_t)(floor_div_wide(dx * one * 2 + stroke.length, 2 * stroke.length));
+		stroke.uy = (int32_t)(floor_div_wide(dy * one * 2 + stroke.length, 2 * stroke.length));
+	}
+
+	int32_t first = (int32_t)floor_div_wide((int64_t)top - stroke.half - 256, 256);
+	int32_t last = (int32_t)floor_div_wide((int64_t)bottom + stroke.half + 256, 256) + 1;
+
+	batch_start(&aa.batch, ctx, colour);
+	aa.edge_count = 0U;
+	aa.covered = 0U;
+	if (!clip_rows(&aa.batch, &first, &last))
+		return;
+
+	/* Across and along distances are linear along a row; Q8 + STROKE_BITS */
+	const int64_t across_step = (int64_t)stroke.uy * 256;
+	const int64_t along_step = (int64_t)stroke.ux * 256;
+	const int64_t outside = (int64_t)(stroke.half + 128) * one;
+	const int64_t inside = (int64_t)(stroke.half - 128) * one;
+	const int64_t end = (int64_t)stroke.length * one;
+	const int64_t margin = 128 * one;
+
+	for (int32_t y = first; y <= last; ++y)
+	{
+		const int64_t ry = (int64_t)y * 256 - stroke.ay;
+		const int64_t across = -(int64_t)stroke.ax * stroke.uy - ry * stroke.ux;
+		const int64_t along = -(int64_t)stroke.ax * stroke.ux + ry * stroke.uy;
+		interval_t width_part;
+		interval_t length_part;
+		interval_t any;
+		interval_t core;
+		uint8_t core_count = 0U;
+
+		if (!linear_range(across, across_step, 1 - outside, outside - 1, &width_part) ||
+		    !linear_range(along, along_step, 1 - margin, end + margin - 1, &length_part) ||
+		    !intersect_pair(&width_part, &length_part, &any))
+			continue;
+
+		/* Pixels at least half a pixel inside every edge are solid */
+		if ((inside >= 0) && (end >= 2 * margin) &&
+		    linear_range(across, across_step, -inside, inside, &width_part) &&
+		    linear_range(along, along_step, margin, end - margin, &length_part))
+			core_count = intersect_pair(&width_part, &length_part, &core);
+
+		aa_row(&aa, y, &any, 1U, &core, core_count, stroke_coverage, &stroke);
+	}
+
+	aa_flush(&aa);
+}
+
+/**
+ * @brief An arc's band and cut ends, for edge coverage.
+ */
+typedef struct
+{
+	int32_t cx;
+	int32_t cy;
+	int32_t outer; /* Q8 edge radii; inner < 0 when there is no hole */
+	int32_t inner;
+	uint8_t partial;
+	uint8_t wide;
+	int16_t start[2];
+	int16_t end[2];
+} band_t;
+
+/**
+ * @brief Coverage from the distance to the nearer circle edge, times
+ *        that from the distance to the cut ends.
+ */
+static uint8_t band_coverage(const void *shape, int32_t x, int32_t y)
+{
+	const band_t *band = (const band_t *)shape;
+	const int32_t dx = x - band->cx;
+	const int32_t dy = y - band->cy;
+	const uint64_t squared = (uint64_t)((int64_t)dx * dx + (int64_t)dy * dy);
+	const int32_t r = (int32_t)((squared < 65536U) ? isqrt((uint32_t)squared << 16)
+						       : isqrt_wide(squared << 16));
+	int32_t radial = band->outer - r;
+	int32_t angular = 256;
+
+	if ((band->inner >= 0) && (r - band->inner < radial))
+		radial = r - band->inner;
+
+	if (band->partial)
+	{
+		/* Signed distance from each cut, Q14 down to Q8 */
+		const int32_t after = clamp_coverage(((band->start[1] * dx + band->start[0] * dy) >> 6) + 128);
+		const int32_t before = clamp_coverage((-(band->end[1] * dx + band->end[0] * dy) >> 6) + 128);
+
+		if (band->wide)
+			angular = (after > before) ? after : before;
+		else
+			angular = (after < before) ? after : before;
+	}
+
+	return coverage_of(radial + 128, angular);
+}
+
+/**
+ * @brief Smallest integer whose square is at least @p value.
+ */
+static int32_t isqrt_up(uint32_t value)
+{
+	const uint32_t root = isqrt(value);
+
+	return (int32_t)((root * root < value) ? (root + 1U) : root);
+}
+
+void lcd_ui_draw_arc_aa(lcd_ui_context_t *ctx,
+			int16_t cx, int16_t cy, uint16_t radius,
+			uint16_t thickness,
+			int16_t start_angle, int16_t sweep,
+			uint32_t colour)
+{
+	if (!ctx || !ctx->driver || (thickness == 0U) || (sweep == 0))
+		return;
+
+	if (sweep < 0)
+	{
+		start_angle = (int16_t)(start_angle + sweep);
+		sweep = (int16_t)-sweep;
+	}
+
+	/* Edges at radius + 1/2 and radius - thickness + 1/2, like draw_arc */
+	aa_batch_t aa;
+	band_t band;
+	const int32_t outer = radius;
+	const int32_t inner = (thickness <= radius) ? (int32_t)radius - thickness : -1;
+	const int32_t first_angle = (int32_t)start_angle * (int32_t)LCD_UI_ANGLE_TURN / 360;
+	const int32_t last_angle = (int32_t)(start_angle + sweep) * (int32_t)LCD_UI_ANGLE_TURN / 360;
+	int32_t y0 = cy - outer;
+	int32_t y1 = cy + outer;
+
+	band.cx = cx;
+	band.cy = cy;
+	band.outer = outer * 256 + 128;
+	band.inner = (inner >= 0) ? inner * 256 + 128 : -1;
+	band.partial = (sweep < 360);
+	band.wide = (sweep > 180);
+	band.start[0] = lcd_ui_sin((uint16_t)first_angle);
+	band.start[1] = lcd_ui_cos((uint16_t)first_angle);
+	band.end[0] = lcd_ui_sin((uint16_t)last_angle);
+	band.end[1] = lcd_ui_cos((uint16_t)last_angle);
+
+	batch_start(&aa.batch, ctx, colour);
+	aa.edge_count = 0U;
+	aa.covered = 0U;
+	if (!clip_rows(&aa.batch, &y0, &y1))
+		return;
+
+	for (int32_t y = y0; y <= y1; ++y)
+	{
+		const int32_t dy = y - cy;
+		const uint32_t d2 = (uint32_t)(dy * dy);
+		const int32_t reach = (int32_t)isqrt((uint32_t)((outer + 1) * (outer + 1) - 1) - d2);
+		interval_t ring_any[2];
+		interval_t ring_core[2];
+		interval_t sector_any[2];
+		interval_t sector_core[2];
+		interval_t any[4];
+		interval_t core[4];
+		uint8_t ring_any_count = 1U;
+		uint8_t ring_core_count = 0U;
+		uint8_t sector_any_count = 1U;
+		uint8_t sector_core_count = 1U;
+
+		/* Some coverage: inside radius + 1, outside the hole's edge */
+		ring_any[0].low = -reach;
+		ring_any[0].high = reach;
+		if ((inner >= 0) && (d2 <= (uint32_t)(inner * inner)))
+		{
+			const int32_t hole = (int32_t)isqrt((uint32_t)(inner * inner) - d2);
+
+			ring_any[0].high = -hole - 1;
+			ring_any[1].low = hole + 1;
+			ring_any[1].high = reach;
+			ring_any_count = 2U;
+		}
+
+		/* Full coverage: within radius, and radius - thickness + 1 */
+		if (d2 <= (uint32_t)(outer * outer))
+		{
+			const int32_t solid = (int32_t)isqrt((uint32_t)(outer * outer) - d2);
+			const int32_t edge = inner + 1;
+			const int32_t hole = ((inner >= 0) && (d2 < (uint32_t)(edge * edge)))
+						 ? isqrt_up((uint32_t)(edge * edge) - d2)
+						 : 0;
+
+			if (hole == 0)
+			{
+				ring_core[0].low = -solid;
+				ring_core[0].high = solid;
+				ring_core_count = 1U;
+			}
+			else if (hole <= solid)
+			{
+				ring_core[0].low = -solid;
+				ring_core[0].high = -hole;
+				ring_core[1].low = hole;
+				ring_core[1].high = solid;
+				ring_core_count = 2U;
+			}
+		}
+
+		if (band.partial)
+		{
+			/* Within half a pixel of the cuts, and at least half inside */
+			sector_any_count = sector_row(dy, 8128, band.start, band.end, band.wide, sector_any);
+			sector_core_count = sector_row(dy, -8192, band.start, band.end, band.wide, sector_core);
+		}
+		else
+		{
+			sector_any[0].low = INT32_MIN;
+			sector_any[0].high = INT32_MAX;
+			sector_core[0] = sector_any[0];
+		}
+
+		const uint8_t any_count = intersect_rows(ring_any, ring_any_count, sector_any, sector_any_count, any);
+		const uint8_t core_count = intersect_rows(ring_core, ring_core_count, sector_core, sector_core_count, core);
+
+		for (uint8_t i = 0U; i < any_count; ++i)
+		{
+			any[i].low += cx;
+			any[i].high += cx;
+		}
+		for (uint8_t i = 0U; i < core_count; ++i)
+		{
+			core[i].low += cx;
+			core[i].high += cx;
+		}
+
+		aa_row(&aa, y, any, any_count, core, core_count, band_coverage, &band);
+	}
+
+	aa_flush(&aa);
+}
@@ -0,0 +1,443 @@
+/**
+ * @file        lcd_ui_surface.c
+ * @brief       Offscreen surfaces caching the static layer of widgets.
+ *
+ * @author      Ryan Hicks <c3361231@uon.edu.au>
+ *              School of Engineering (Electrical and Computer Engineering)
+ *              University of Newcastle
+ *
+ * @date        2025-04-11
+ * @version     1.0.0
+ *
+ * @copyright   Copyright (c) 2025 Ryan
+ * @license     SPDX-License-Identifier: MIT
+ *
+ * @note        Redistribution and use permitted with attribution.
+ */
+
+#include "lcd_ui_surface.h"
+
+#include <string.h>
+
+/**
+ * @brief Driver instance for rendering into a surface. Fonts come from
+ *        the screen's driver so text looks the same in both.
+ */
+typedef struct
+{
+	uint32_t *pixels;
+	uint16_t width;
+	uint16_t height;
+	const lcd_ui_driver_t *screen;
+	void *screen_instance;
+} surface_target_t;
+
+static void target_init(void *instance)
+{
+	(void)instance;
+}
+
+static void target_draw_rect(void *instance, uint16_t x, uint16_t y,
+			     uint16_t w, uint16_t h, uint32_t colour)
+{
+	const surface_target_t *target = (const surface_target_t *)instance;
+
+	if ((x >= target->width) || (y >= target->height))
+		return;
+	if (w > target->width - x)
+		w = target->width - x;
+	if (h > target->height - y)
+		h = target->height - y;
+
+	for (uint16_t row = 0U; row < h; ++row)
+	{
+		uint32_t *dst = target->pixels + (size_t)(y + row) * target->width + x;
+		for (uint16_t col = 0U; col < w; ++col)
+		{
+			dst[col] = colour;
+		}
+	}
+}
+
+static void target_draw_pixel(void *instance, uint16_t x, uint16_t y, uint32_t colour)
+{
+	target_draw_rect(instance, x, y, 1U, 1U, colour);
+}
+
+static void target_clear(void *instance, uint32_t colour)
+{
+	const surface_target_t *target = (const surface_target_t *)instance;
+
+	target_draw_rect(instance, 0U, 0U, target->width, target->height, colour);
+}
+
+static void target_get_screen_size(void *instance, uint16_t *w, uint16_t *h)
+{
+	const surface_target_t *target = (const surface_target_t *)instance;
+
+	*w = target->width;
+	*h = target->height;
+}
+
+static uint16_t target_get_font_width(void *instance)
+{
+	const surface_target_t *target = (const surface_target_t *)instance;
+
+	return target->screen->get_font_width(target->screen_instance);
+}
+
+static uint16_t target_get_font_height(void *instance)
+{
+	const surface_target_t *target = (const surface_target_t *)instance;
+
+	return target->screen->get_font_height(target->screen_instance);
+}
+
+static const uint8_t *target_get_glyph(void *instance, char c)
+{
+	const surface_target_t *target = (const surface_target_t *)instance;
+
+	return target->screen->get_glyph ? target->screen->get_glyph(target->screen_instance, c)
+					 : NULL;
+}
+
+/**
+ * @brief Rasterises text from the screen driver's glyphs, aligned the
+ *        way the panel drivers align it: relative to the whole line.
+ *        Without get_glyph, text is left out of cached layers.
+ */
+static void target_draw_text(void *instance, uint16_t x, uint16_t y,
+			     const char *text, uint32_t text_colour,
+			     uint32_t background_colour, lcd_ui_align_t align)
+{
+	const surface_target_t *target = (const surface_target_t *)instance;
+	const uint16_t font_w = target_get_font_width(instance);
+	const uint16_t font_h = target_get_font_height(instance);
+	const uint16_t row_bytes = (font_w + 7U) / 8U;
+	const uint32_t text_w = (uint32_t)strlen(text) * font_w;
+
+	if (!target->screen->get_glyph)
+		return;
+
+	if (text_w < target->width)
+	{
+		if (align == LCD_UI_ALIGN_CENTER)
+			x = x + (uint16_t)((target->width - text_w) / 2U);
+		else if (align == LCD_UI_ALIGN_RIGHT)
+			x = (uint16_t)(target->width - text_w - x);
+	}
+
+	for (; (*text != '\0') && (x < target->width); ++text, x += font_w)
+	{
+		const uint8_t *glyph = target_get_glyph(instance, *text);
+
+		if (glyph == NULL)
+			continue;
+
+		for (uint16_t row = 0U; (row < font_h) && (y + row < target->height); ++row)
+		{
+			const uint8_t *bits = glyph + (size_t)row * row_bytes;
+			uint32_t *dst = target->pixels + (size_t)(y + row) * target->width + x;
+
+			for (uint16_t col = 0U; (col < font_w) && (x + col < target->width); ++col)
+			{
+				dst[col] = (bits[col / 8U] & (0x80U >> (col % 8U))) ? text_colour
+										    : background_colour;
+			}
+		}
+	}
+}
+
+static uint8_t target_get_framebuffer(void *instance, lcd_ui_framebuffer_t *framebuffer)
+{
+	const surface_target_t *target = (const surface_target_t *)instance;
+
+	framebuffer->pixels = target->pixels;
+	framebuffer->width = target->width;
+	framebuffer->height = target->height;
+	framebuffer->stride = target->width;
+	framebuffer->format = LCD_UI_PIXEL_ARGB8888;
+	return 1U;
+}
+
+/* Bitmaps and block moves go through get_framebuffer */
+static const lcd_ui_driver_t surface_driver = {
+    .init = target_init,
+    .draw_pixel = target_draw_pixel,
+    .draw_rect = target_draw_rect,
+    .draw_text = target_draw_text,
+    .clear = target_clear,
+    .get_screen_size = target_get_screen_size,
+    .get_font_width = target_get_font_width,
+    .get_font_height = target_get_font_height,
+    .get_framebuffer = target_get_framebuffer,
+    .get_glyph = target_get_glyph,
+};
+
+/**
+ * @brief Sets up @p offscreen to draw into @p target with the screen's
+ *        theme, over @p background.
+ */
+static void offscreen_init(lcd_ui_context_t *offscreen, surface_target_t *target,
+			   lcd_ui_widget_t **slot, const lcd_ui_context_t *ctx,
+			   uint32_t background)
+{
+	lcd_ui_init(offscreen, &surface_driver, target, slot, 0U);
+	offscreen->styles = ctx->styles;
+	offscreen->style_count = ctx->style_count;
+	offscreen->theme_version = ctx->theme_version;
+	offscreen->background_colour = background;
+	target_clear(target, background);
+}
+
+static size_t surface_pixels(const lcd_ui_surface_t *surface)
+{
+	return (size_t)surface->width * surface->height;
+}
+
+/**
+ * @brief Moves the cached layers down to the start of the arena, in
+ *        address order, so the free space is one block at the end.
+ */
+static void compact(lcd_ui_surface_cache_t *cache)
+{
+	uint32_t *cursor = cache->arena;
+
+	for (;;)
+	{
+		lcd_ui_surface_t *lowest = NULL;
+
+		for (lcd_ui_surface_t *s = cache->surfaces; s; s = s->next)
+		{
+			if (s->pixels && (s->pixels >= cursor) &&
+			    (!lowest || (s->pixels < lowest->pixels)))
+				lowest = s;
+		}
+
+		if (!lowest)
+			break;
+
+		if (lowest->pixels != cursor)
+		{
+			memmove(cursor, lowest->pixels, surface_pixels(lowest) * sizeof(uint32_t));
+			lowest->pixels = cursor;
+		}
+		cursor += surface_pixels(lowest);
+	}
+
+	cache->used = (size_t)(cursor - cache->arena);
+}
+
+/**
+ * @brief Finds room for @p pixels, evicting the least recently drawn
+ *        layers until it fits.
+ * @return The storage, or NULL if it exceeds the whole arena.
+ */
+static uint32_t *allocate(lcd_ui_surface_cache_t *cache, size_t pixels)
+{
+	if (pixels > cache->capacity)
+		return NULL;
+
+	if (cache->used + pixels > cache->capacity)
+	{
+		size_t live = 0U;
+
+		for (lcd_ui_surface_t *s = cache->surfaces; s; s = s->next)
+		{
+			if (s->pixels)
+				live += surface_pixels(s);
+		}
+
+		while (live + pixels > cache->capacity)
+		{
+			lcd_ui_surface_t *oldest = NULL;
+
+			for (lcd_ui_surface_t *s = cache->surfaces; s; s = s->next)
+			{
+				if (s->pixels && (!oldest || ((int32_t)(s->last_used - oldest->last_used) < 0)))
+					oldest = s;
+			}
+
+			live -= surface_pixels(oldest);
+			oldest->pixels = NULL;
+			++cache->evictions;
+		}
+
+		compact(cache);
+	}
+
+	uint32_t *storage = cache->arena + cache->used;
+	cache->used += pixels;
+	return storage;
+}
+
+/**
+ * @brief Drops a surface's pixels. The space is reclaimed at once if it
+ *        was the last layer, otherwise at the next compaction.
+ */
+static void release(lcd_ui_surface_t *surface)
+{
+	lcd_ui_surface_cache_t *cache = surface->cache;
+
+	if (!surface->pixels)
+		return;
+
+	if (surface->pixels + surface_pixels(surface) == cache->arena + cache->used)
+		cache->used -= surface_pixels(surface);
+	surface->pixels = NULL;
+}
+
+void lcd_ui_surface_cache_init(lcd_ui_surface_cache_t *cache,
+			       void *buffer, size_t size)
+{
+	if (!cache)
+		return;
+
+	cache->arena = (uint32_t *)buffer;
+	cache->capacity = buffer ? size / sizeof(uint32_t) : 0U;
+	cache->used = 0U;
+	cache->clock = 0U;
+	cache->surfaces = NULL;
+	cache->renders = 0U;
+	cache->evictions = 0U;
+}
+
+void lcd_ui_surface_init(lcd_ui_surface_cache_t *cache,
+			 lcd_ui_surface_t *surface,
+			 lcd_ui_surface_render_t render,
+			 void *user_data)
+{
+	if (!cache || !surface)
+		return;
+
+	/* Initialising a registered surface again must not link it twice */
+	for (lcd_ui_surface_t **link = &cache->surfaces; *link; link = &(*link)->next)
+	{
+		if (*link == surface)
+		{
+			*link = surface->next;
+			surface->cache = cache;
+			release(surface);
+			break;
+		}
+	}
+
+	surface->cache = cache;
+	surface->render = render;
+	surface->user_data = user_data;
+	surface->pixels = NULL;
+	surface->width = 0U;
+	surface->height = 0U;
+	surface->last_used = 0U;
+
+	surface->next = cache->surfaces;
+	cache->surfaces = surface;
+}
+
+void lcd_ui_surface_remove(lcd_ui_surface_t *surface)
+{
+	if (!surface || !surface->cache)
+		return;
+
+	release(surface);
+
+	for (lcd_ui_surface_t **link = &surface->cache->surfaces; *link; link = &(*link)->next)
+	{
+		if (*link == surface)
+		{
+			*link = surface->next;
+			break;
+		}
+	}
+
+	surface->cache = NULL;
+}
+
+void lcd_ui_surface_invalidate(lcd_ui_surface_t *surface)
+{
+	if (!surface || !surface->cache)
+		return;
+
+	release(surface);
+}
+
+uint8_t lcd_ui_surface_draw(lcd_ui_context_t *ctx,
+			    lcd_ui_surface_t *surface,
+			    const lcd_ui_widget_t *widget)
+{
+	if (!ctx || !ctx->driver || !surface || !surface->cache || !surface->render || !widget)
+		return 0U;
+
+	lcd_ui_surface_cache_t *cache = surface->cache;
+	uint32_t background = 0U;
+	uint32_t foreground = 0U;
+
+	lcd_ui_get_widget_colours(ctx, widget, &background, &foreground);
+	surface->last_used = ++cache->clock;
+
+	if (surface->pixels &&
+	    ((surface->width != widget->width) || (surface->height != widget->height) ||
+	     (surface->background != background) || (surface->foreground != foreground) ||
+	     (surface->theme_version != ctx->theme_version)))
+	{
+		release(surface);
+	}
+
+	if (!surface->pixels)
+	{
+		surface->width = widget->width;
+		surface->height = widget->height;
+		surface->pixels = allocate(cache, surface_pixels(surface));
+
+		if (!surface->pixels)
+		{
+			surface->render(ctx, widget, surface->user_data);
+			return 0U;
+		}
+
+		/* Same theme and fonts, drawn at the surface's origin */
+		surface_target_t target = {surface->pixels, widget->width, widget->height,
+					   ctx->driver, ctx->driver_instance};
+		lcd_ui_widget_t *slot = NULL;
+		lcd_ui_context_t offscreen;
+		lcd_ui_widget_t local = *widget;
+
+		offscreen_init(&offscreen, &target, &slot, ctx, background);
+
+		local.x = 0U;
+		local.y = 0U;
+		surface->render(&offscreen, &local, surface->user_data);
+
+		surface->background = background;
+		surface->foreground = foreground;
+		surface->theme_version = ctx->theme_version;
+		++cache->renders;
+	}
+
+	lcd_ui_draw_bitmap(ctx, widget->x, widget->y, surface->width, surface->height,
+			   surface->pixels, surface->width);
+	return 1U;
+}
+
+uint8_t lcd_ui_render_offscreen(lcd_ui_context_t *ctx, uint32_t *pixels, size_t size)
+{
+	if (!ctx || !ctx->driver || !pixels)
+		return 0U;
+
+	if ((size_t)ctx->screen_width * ctx->screen_height * sizeof(uint32_t) > size)
+		return 0U;
+
+	/* The logical screen, unrotated; the widget list is shared, not copied */
+	surface_target_t target = {pixels, ctx->screen_width, ctx->screen_height,
+				   ctx->driver, ctx->driver_instance};
+	lcd_ui_widget_t *slot = NULL;
+	lcd_ui_context_t offscreen;
+
+	offscreen_init(&offscreen, &target, &slot, ctx, ctx->background_colour);
+	offscreen.widgets = ctx->widgets;
+	offscreen.widget_capacity = ctx->widget_capacity;
+	offscreen.widget_count = ctx->widget_count;
+
+	lcd_ui_render(&offscreen);
+	return 1U;
+}
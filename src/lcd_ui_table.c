@@ -0,0 +1,347 @@
+/**
+ * @file        lcd_ui_table.c
+ * @brief       Grid of live values with per-cell dirty tracking.
+ *
+ * @author      Ryan Hicks <c3361231@uon.edu.au>
+ *              School of Engineering (Electrical and Computer Engineering)
+ *              University of Newcastle
+ *
+ * @date        2025-04-11
+ * @version     1.0.0
+ *
+ * @copyright   Copyright (c) 2025 Ryan
+ * @license     SPDX-License-Identifier: MIT
+ *
+ * @note        Redistribution and use permitted with attribution.
+ */
+
+#include "lcd_ui_table.h"
+
+#include <string.h>
+
+/**
+ * @brief Index of the lowest set bit of a non-zero word (de Bruijn).
+ */
+static uint8_t lowest_bit(uint32_t word)
+{
+	static const uint8_t position[32] = {
+	    0U, 1U, 28U, 2U, 29U, 14U, 24U, 3U, 30U, 22U, 20U, 15U, 25U, 17U, 4U, 8U,
+	    31U, 27U, 13U, 23U, 21U, 19U, 16U, 7U, 26U, 12U, 18U, 6U, 11U, 5U, 10U, 9U};
+
+	return position[((word & (0U - word)) * 0x077CB531U) >> 27];
+}
+
+/**
+ * @brief Brings the cached cell size in line with the widget's size.
+ */
+static void layout(lcd_ui_table_t *table, const lcd_ui_widget_t *widget)
+{
+	if ((table->layout_width == widget->width) && (table->layout_height == widget->height))
+		return;
+
+	table->layout_width = widget->width;
+	table->layout_height = widget->height;
+	table->cell_width = (table->columns != 0U) ? (widget->width / table->columns) : 0U;
+	table->cell_height = (table->rows != 0U) ? (widget->height / table->rows) : 0U;
+}
+
+/* An int32 has at most 10 digits; more decimals only add leading zeros */
+#define MAX_DECIMALS 10U
+
+/**
+ * @brief Prints a fixed-point value with @p decimals digits after the
+ *        point, without printf. Decimals beyond MAX_DECIMALS are ignored.
+ */
+static void format_value(int32_t value, uint8_t decimals, char *text, size_t size)
+{
+	char digits[MAX_DECIMALS + 2U];
+	uint8_t count = 0U;
+	size_t length = 0U;
+	uint32_t magnitude = (value < 0) ? (0U - (uint32_t)value) : (uint32_t)value;
+
+	if (decimals > MAX_DECIMALS)
+		decimals = MAX_DECIMALS;
+
+	do
+	{
+		digits[count++] = (char)('0' + magnitude % 10U);
+		magnitude /= 10U;
+	} while ((magnitude != 0U) || (count <= decimals));
+
+	if ((value < 0) && (length + 1U < size))
+		text[length++] = '-';
+
+	while ((count > 0U) && (length + 1U < size))
+	{
+		if ((count == decimals) && (decimals != 0U))
+		{
+			text[length++] = '.';
+			if (length + 1U >= size)
+				break;
+		}
+		text[length++] = digits[--count];
+	}
+
+	text[length] = '\0';
+}
+
+/**
+ * @brief Draws one cell, cut to ctx->clip, with its grid lines on the
+ *        right and bottom edges.
+ */
+static void draw_cell(lcd_ui_context_t *ctx, const lcd_ui_widget_t *widget,
+		      const lcd_ui_table_t *table, uint16_t row, uint16_t column,
+		      uint32_t background, uint32_t foreground, uint32_t line,
+		      uint16_t margin)
+{
+	const uint16_t x = widget->x + column * table->cell_width;
+	const uint16_t y = widget->y + row * table->cell_height;
+	const uint16_t inner_w = table->cell_width - 1U;
+	const uint16_t inner_h = table->cell_height - 1U;
+	char text[LCD_UI_TABLE_TEXT_SIZE];
+
+	lcd_ui_fill_rect(ctx, x, y, inner_w, inner_h, background);
+	lcd_ui_fill_rect(ctx, x + inner_w, y, 1U, table->cell_height, line);
+	lcd_ui_fill_rect(ctx, x, y + inner_h, inner_w, 1U, line);
+
+	text[0] = '\0';
+	if (table->format_cell)
+		table->format_cell(table->source, row, column, text, sizeof(text));
+	else if (table->values.base)
+		format_value(lcd_ui_sample_read(&table->values, (uint32_t)row * table->columns + column),
+			     table->decimals, text, sizeof(text));
+	text[sizeof(text) - 1U] = '\0';
+
+	if (text[0] == '\0')
+		return;
+
+	const uint16_t font_w = ctx->driver->get_font_width(ctx->driver_instance);
+	const uint16_t font_h = ctx->driver->get_font_height(ctx->driver_instance);
+
+	if ((font_w == 0U) || (font_h > inner_h) || (inner_w <= 2U * margin))
+		return;
+
+	/* Cut the text to the cell rather than let it spill over */
+	size_t length = strlen(text);
+	const size_t fits = (inner_w - 2U * margin) / font_w;
+	if (length > fits)
+	{
+		length = fits;
+		text[length] = '\0';
+	}
+	if (length == 0U)
+		return;
+
+	const uint16_t text_w = (uint16_t)(length * font_w);
+	uint16_t text_x;
+	switch (widget->text_align)
+	{
+	case LCD_UI_ALIGN_CENTER:
+		text_x = x + (inner_w - text_w) / 2U;
+		break;
+	case LCD_UI_ALIGN_RIGHT:
+		text_x = x + inner_w - text_w - margin;
+		break;
+	case LCD_UI_ALIGN_LEFT:
+	default:
+		text_x = x + margin;
+		break;
+	}
+
+	lcd_ui_draw_text(ctx, text_x, y + (inner_h - font_h) / 2U, text, foreground, background);
+}
+
+void lcd_ui_table_init(lcd_ui_table_t *table,
+		       uint16_t rows, uint16_t columns,
+		       uint32_t *dirty)
+{
+	if (!table)
+		return;
+
+	memset(table, 0, sizeof(*table));
+	table->rows = rows;
+	table->columns = columns;
+	table->dirty = dirty;
+
+	if (dirty)
+		memset(dirty, 0, LCD_UI_TABLE_DIRTY_WORDS(rows, columns) * sizeof(uint32_t));
+}
+
+void lcd_ui_table_mark(lcd_ui_table_t *table, uint16_t row, uint16_t column)
+{
+	if (!table || !table->dirty || (row >= table->rows) || (column >= table->columns))
+		return;
+
+	const uint32_t cell = (uint32_t)row * table->columns + column;
+	table->dirty[cell / 32U] |= 1UL << (cell % 32U);
+}
+
+void lcd_ui_table_mark_all(lcd_ui_table_t *table)
+{
+	if (!table || !table->dirty)
+		return;
+
+	const uint32_t cells = (uint32_t)table->rows * table->columns;
+	const uint32_t words = LCD_UI_TABLE_DIRTY_WORDS(table->rows, table->columns);
+
+	memset(table->dirty, 0xFF, (size_t)words * sizeof(uint32_t));
+	if (cells % 32U)
+		table->dirty[words - 1U] = (1UL << (cells % 32U)) - 1U;
+}
+
+void lcd_ui_table_update(lcd_ui_context_t *ctx, lcd_ui_widget_t *widget)
+{
+	if (!ctx || !widget || (widget->type != LCD_UI_WIDGET_TABLE) || !widget->data)
+		return;
+
+	lcd_ui_table_t *table = (lcd_ui_table_t *)widget->data;
+	if (!table->dirty)
+		return;
+
+	const uint32_t words = LCD_UI_TABLE_DIRTY_WORDS(table->rows, table->columns);
+	const lcd_ui_rect_t saved_clip = ctx->clip;
+
+	layout(table, widget);
+
+	for (uint32_t w = 0U; w < words; ++w)
+	{
+		uint32_t pending = table->dirty[w];
+		table->dirty[w] = 0U;
+
+		while (pending != 0U)
+		{
+			const uint32_t cell = w * 32U + lowest_bit(pending);
+			const uint16_t row = (uint16_t)(cell / table->columns);
+			const uint16_t column = (uint16_t)(cell - (uint32_t)row * table->columns);
+			const uint16_t x0 = widget->x + column * table->cell_width;
+			const uint16_t y0 = widget->y + row * table->cell_height;
+			const uint16_t left = (x0 > saved_clip.x) ? x0 : saved_clip.x;
+			const uint16_t top = (y0 > saved_clip.y) ? y0 : saved_clip.y;
+			const uint32_t right = ((uint32_t)x0 + table->cell_width < (uint32_t)saved_clip.x + saved_clip.width)
+						   ? ((uint32_t)x0 + table->cell_width)
+						   : ((uint32_t)saved_clip.x + saved_clip.width);
+			const uint32_t bottom = ((uint32_t)y0 + table->cell_height < (uint32_t)saved_clip.y + saved_clip.height)
+						    ? ((uint32_t)y0 + table->cell_height)
+						    : ((uint32_t)saved_clip.y + saved_clip.height);
+
+			pending &= pending - 1U;
+
+			if ((right <= left) || (bottom <= top))
+				continue;
+
+			/* Redrawn through the widget so overlays stay on top */
+			ctx->clip.x = left;
+			ctx->clip.y = top;
+			ctx->clip.width = (uint16_t)(right - left);
+			ctx->clip.height = (uint16_t)(bottom - top);
+			lcd_ui_redraw_widget(ctx, widget);
+			ctx->clip = saved_clip;
+		}
+	}
+}
+
+uint8_t lcd_ui_table_cell_at(const lcd_ui_widget_t *widget,
+			     uint16_t x, uint16_t y,
+			     uint16_t *row, uint16_t *column)
+{
+	if (!widget || (widget->type != LCD_UI_WIDGET_TABLE) || !widget->data ||
+	    (x < widget->x) || (y < widget->y))
+		return 0U;
+
+	lcd_ui_table_t *table = (lcd_ui_table_t *)widget->data;
+	layout(table, widget);
+
+	if ((table->cell_width == 0U) || (table->cell_height == 0U))
+		return 0U;
+
+	const uint16_t c = (x - widget->x) / table->cell_width;
+	const uint16_t r = (y - widget->y) / table->cell_height;
+
+	if ((r >= table->rows) || (c >= table->columns))
+		return 0U;
+
+	if (row)
+		*row = r;
+	if (column)
+		*column = c;
+	return 1U;
+}
+
+void lcd_ui_table_touch(lcd_ui_context_t *ctx, lcd_ui_widget_t *widget,
+			uint16_t x, uint16_t y)
+{
+	if (!ctx || !widget || !widget->data)
+		return;
+
+	lcd_ui_table_t *table = (lcd_ui_table_t *)widget->data;
+
+	if (!lcd_ui_table_cell_at(widget, x, y, &table->touched_row, &table->touched_column))
+		return;
+
+	if (widget->on_touch)
+	{
+		widget->on_touch(ctx, widget, x, y, widget->user_data);
+	}
+}
+
+void lcd_ui_table_draw(lcd_ui_context_t *ctx,
+		       const lcd_ui_widget_t *widget,
+		       uint32_t background, uint32_t foreground)
+{
+	if (!ctx || !widget)
+		return;
+
+	lcd_ui_table_t *table = (lcd_ui_table_t *)widget->data;
+
+	if (!table)
+	{
+		lcd_ui_fill_rect(ctx, widget->x, widget->y, widget->width, widget->height, background);
+		return;
+	}
+
+	layout(table, widget);
+
+	const lcd_ui_style_t *style = lcd_ui_get_widget_style(ctx, widget);
+	const uint32_t line = style ? style->shades.disabled : blend_colours(foreground, background, 128U);
+	const uint16_t margin = style ? style->margin : 1U;
+	const uint16_t grid_w = table->cell_width * table->columns;
+	const uint16_t grid_h = table->cell_height * table->rows;
+
+	/* Strips the equal cells leave over on the right and bottom */
+	if (grid_w < widget->width)
+		lcd_ui_fill_rect(ctx, widget->x + grid_w, widget->y,
+				 widget->width - grid_w, widget->height, background);
+	if (grid_h < widget->height)
+		lcd_ui_fill_rect(ctx, widget->x, widget->y + grid_h,
+				 grid_w, widget->height - grid_h, background);
+
+	if ((table->cell_width < 2U) || (table->cell_height < 2U))
+		return;
+
+	/* Only the cells inside the clip, found by division */
+	const int32_t left = (int32_t)ctx->clip.x - widget->x;
+	const int32_t top = (int32_t)ctx->clip.y - widget->y;
+	const int32_t right = left + ctx->clip.width;
+	const int32_t bottom = top + ctx->clip.height;
+
+	if ((right <= 0) || (bottom <= 0) || (left >= grid_w) || (top >= grid_h))
+		return;
+
+	const uint16_t first_column = (left > 0) ? (uint16_t)(left / table->cell_width) : 0U;
+	const uint16_t first_row = (top > 0) ? (uint16_t)(top / table->cell_height) : 0U;
+	uint16_t end_column = (uint16_t)((right + table->cell_width - 1) / table->cell_width);
+	uint16_t end_row = (uint16_t)((bottom + table->cell_height - 1) / table->cell_height);
+
+	if (end_column > table->columns)
+		end_column = table->columns;
+	if (end_row > table->rows)
+		end_row = table->rows;
+
+	for (uint16_t row = first_row; row < end_row; ++row)
+	{
+		for (uint16_t column = first_column; column < end_column; ++column)
+		{
+			draw_cell(ctx, widget, table, row, column, background, foreground, line, margin);
+		}
+	}
+}
@@ -0,0 +1,185 @@
+/**
+ * @file        lcd_ui_transition.c
+ * @brief       Slide and push page transitions done with block moves.
+ *
+ * @author      Ryan Hicks <c3361231@uon.edu.au>
+ *              School of Engineering (Electrical and Computer Engineering)
+ *              University of Newcastle
+ *
+ * @date        2025-04-11
+ * @version     1.0.0
+ *
+ * @copyright   Copyright (c) 2025 Ryan
+ * @license     SPDX-License-Identifier: MIT
+ *
+ * @note        Redistribution and use permitted with attribution.
+ */
+
+#include "lcd_ui_transition.h"
+#include "lcd_ui_surface.h"
+
+/* Easing works in 16.16 fixed point */
+#define PROGRESS_ONE 65536U
+
+static uint8_t is_horizontal(const lcd_ui_transition_t *trans)
+{
+	return (trans->edge == LCD_UI_FROM_RIGHT) || (trans->edge == LCD_UI_FROM_LEFT);
+}
+
+/**
+ * @brief Whether the new page comes in at the far end of the axis, so
+ *        the pages move towards 0.
+ */
+static uint8_t from_far_edge(const lcd_ui_transition_t *trans)
+{
+	return (trans->edge == LCD_UI_FROM_RIGHT) || (trans->edge == LCD_UI_FROM_BOTTOM);
+}
+
+/**
+ * @brief The full-width (or full-height) band from @p start along the
+ *        axis of the move.
+ */
+static lcd_ui_rect_t band(const lcd_ui_transition_t *trans, uint16_t start, uint16_t length)
+{
+	const lcd_ui_context_t *ctx = trans->ctx;
+
+	if (is_horizontal(trans))
+		return (lcd_ui_rect_t){start, 0U, length, ctx->screen_height};
+
+	return (lcd_ui_rect_t){0U, start, ctx->screen_width, length};
+}
+
+/**
+ * @brief Copies the band at @p source in a page buffer to @p start on
+ *        screen.
+ */
+static void copy_band(const lcd_ui_transition_t *trans, const uint32_t *page,
+		      uint16_t start, uint16_t source, uint16_t length)
+{
+	lcd_ui_context_t *ctx = trans->ctx;
+	const lcd_ui_rect_t area = band(trans, start, length);
+
+	if (length == 0U)
+		return;
+
+	page += is_horizontal(trans) ? source : (size_t)source * ctx->screen_width;
+	lcd_ui_draw_bitmap(ctx, area.x, area.y, area.width, area.height, page, ctx->screen_width);
+}
+
+/**
+ * @brief Moves the pages from @c trans->offset to @p offset.
+ */
+static void draw_frame(lcd_ui_transition_t *trans, uint16_t offset)
+{
+	const uint16_t distance = trans->distance;
+	const uint16_t previous = trans->offset;
+	const uint16_t delta = offset - previous;
+	const uint8_t far = from_far_edge(trans);
+	const int16_t shift = far ? -(int16_t)delta : (int16_t)delta;
+	lcd_ui_rect_t moving;
+	uint8_t moved;
+
+	/* A push moves everything; a slide only the part of the new page already in */
+	if (trans->style == LCD_UI_TRANSITION_PUSH)
+		moving = band(trans, 0U, distance);
+	else
+		moving = band(trans, far ? (uint16_t)(distance - previous) : 0U, previous);
+
+	if (!is_horizontal(trans))
+		moved = lcd_ui_move_pixels(trans->ctx, &moving, 0, shift);
+	else
+		moved = lcd_ui_move_pixels(trans->ctx, &moving, shift, 0);
+
+	if (moved)
+	{
+		/* Only the strip just uncovered comes from the buffer */
+		if (far)
+			copy_band(trans, trans->incoming, (uint16_t)(distance - delta), previous, delta);
+		else
+			copy_band(trans, trans->incoming, 0U, (uint16_t)(distance - offset), delta);
+	}
+	else
+	{
+		if (far)
+			copy_band(trans, trans->incoming, (uint16_t)(distance - offset), 0U, offset);
+		else
+			copy_band(trans, trans->incoming, 0U, (uint16_t)(distance - offset), offset);
+
+		if ((trans->style == LCD_UI_TRANSITION_PUSH) && trans->outgoing)
+		{
+			if (far)
+				copy_band(trans, trans->outgoing, 0U, offset, (uint16_t)(distance - offset));
+			else
+				copy_band(trans, trans->outgoing, offset, 0U, (uint16_t)(distance - offset));
+		}
+	}
+
+	trans->offset = offset;
+	++trans->frames;
+}
+
+uint8_t lcd_ui_transition_start(lcd_ui_transition_t *trans, lcd_ui_context_t *ctx,
+				uint32_t *page_buffer, size_t size,
+				const uint32_t *outgoing, uint32_t background,
+				lcd_ui_transition_style_t style, lcd_ui_edge_t edge,
+				uint32_t duration_us, lcd_ui_easing_t easing)
+{
+	if (!trans || !ctx || !ctx->driver)
+		return 0U;
+
+	trans->ctx = ctx;
+	trans->incoming = page_buffer;
+	trans->outgoing = outgoing;
+	trans->start_us = 0U;
+	trans->duration_us = duration_us;
+	trans->offset = 0U;
+	trans->style = (uint8_t)style;
+	trans->edge = (uint8_t)edge;
+	trans->easing = (uint8_t)easing;
+	trans->started = 0U;
+	trans->running = 0U;
+	trans->frames = 0U;
+	trans->distance = is_horizontal(trans) ? ctx->screen_width : ctx->screen_height;
+
+	ctx->background_colour = background;
+
+	if (!lcd_ui_render_offscreen(ctx, page_buffer, size))
+	{
+		const lcd_ui_rect_t screen = {0U, 0U, ctx->screen_width, ctx->screen_height};
+
+		lcd_ui_repaint_area(ctx, &screen);
+		return 0U;
+	}
+
+	trans->running = 1U;
+	return 1U;
+}
+
+uint8_t lcd_ui_transition_step(lcd_ui_transition_t *trans, uint32_t now_us)
+{
+	if (!trans || !trans->running)
+		return 0U;
+
+	if (!trans->started)
+	{
+		trans->start_us = now_us;
+		trans->started = 1U;
+	}
+
+	const uint32_t elapsed = now_us - trans->start_us;
+	uint32_t progress = PROGRESS_ONE;
+
+	if (elapsed < trans->duration_us)
+		progress = (uint32_t)(((uint64_t)elapsed << 16) / trans->duration_us);
+
+	const uint32_t eased = lcd_ui_ease((lcd_ui_easing_t)trans->easing, progress);
+	const uint16_t offset = (uint16_t)(((uint64_t)eased * trans->distance + PROGRESS_ONE / 2U) >> 16);
+
+	if (offset > trans->offset)
+		draw_frame(trans, offset);
+
+	if (progress == PROGRESS_ONE)
+		trans->running = 0U;
+
+	return trans->running;
+}
@@ -17,13 +17,16 @@
 
 #include "touch_ui.h"
 
-void touch_ui_init(touch_ui_context_t *context, const touch_ui_driver_t *driver)
+void touch_ui_init(touch_ui_context_t *context,
+		   const touch_ui_driver_t *driver,
+		   void *driver_instance)
 {
 	if (!context || !driver)
 		return;
 
-	driver->initialize();
+	driver->initialize(driver_instance);
 	context->driver = driver;
+	context->driver_instance = driver_instance;
 
 	context->internal_state.last_press_state = false;
 	context->internal_state.last_x_position = 0U;
@@ -104,5 +107,6 @@ bool touch_ui_read_state(touch_ui_context_t *context,
 	if (!context || !context->driver || !context->driver->read_touch_state)
 		return false;
 
-	return context->driver->read_touch_state(x, y, pressed, timestamp);
+	return context->driver->read_touch_state(context->driver_instance,
+						 x, y, pressed, timestamp);
 }
\ No newline at end of file
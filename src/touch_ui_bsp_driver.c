@@ -19,21 +19,27 @@
 #include "stm32h747i_discovery_ts.h" // STM32 board specific touchscreen header
 #include "main.h"
 
-static TS_State_t internal_ts_state; /* Track last read */
-static TS_Init_t internal_ts_init;   /* Config used during init */
+touch_ui_bsp_instance_t touch_ui_bsp_instance = {
+    .ts_instance = 0U,
+    .last_x_position = 0U,
+    .last_y_position = 0U,
+};
 
 /**
  * @brief  Initializes the STM32H747I-Discovery touchscreen hardware.
  *         Sets orientation, accuracy, etc., as described in your note.
  */
-static void initialize_touchscreen(void)
+static void initialize_touchscreen(void *instance)
 {
+	touch_ui_bsp_instance_t *bsp = (touch_ui_bsp_instance_t *)instance;
+	TS_Init_t internal_ts_init;
+
 	internal_ts_init.Width = TS_MAX_WIDTH;
 	internal_ts_init.Height = TS_MAX_HEIGHT;
 	internal_ts_init.Orientation = TS_SWAP_XY | TS_SWAP_Y;
 	internal_ts_init.Accuracy = 5U;
 
-	if (BSP_TS_Init(0, &internal_ts_init) != BSP_ERROR_NONE)
+	if (BSP_TS_Init(bsp->ts_instance, &internal_ts_init) != BSP_ERROR_NONE)
 	{
 		Error_Handler();
 	}
@@ -44,13 +50,15 @@ static void initialize_touchscreen(void)
 
 /**
  * @brief  Reads the current touch state from the hardware.
+ * @param  instance Pointer to the touch_ui_bsp_instance_t
  * @param  x_position Pointer to store the X coordinate
  * @param  y_position Pointer to store the Y coordinate
  * @param  is_pressed Pointer to store press boolean
  * @param  timestamp_value Pointer to store a time value (e.g. from HAL_GetTick)
  * @return True if read is valid, false otherwise
  */
-static bool read_touch_state(uint16_t *x_position,
+static bool read_touch_state(void *instance,
+			     uint16_t *x_position,
 			     uint16_t *y_position,
 			     bool *is_pressed,
 			     uint32_t *timestamp_value)
@@ -63,25 +71,27 @@ static bool read_touch_state(uint16_t *x_position,
 		return false;
 	}
 
-	(void)BSP_TS_GetState(0, &internal_ts_state);
+	touch_ui_bsp_instance_t *bsp = (touch_ui_bsp_instance_t *)instance;
+	TS_State_t internal_ts_state;
+
+	(void)BSP_TS_GetState(bsp->ts_instance, &internal_ts_state);
 
 	/* If there's a touch: the driver sets TouchDetected != 0U */
 	if (internal_ts_state.TouchDetected != 0U)
 	{
-		*x_position = (uint16_t)internal_ts_state.TouchX;
-		*y_position = (uint16_t)internal_ts_state.TouchY;
+		bsp->last_x_position = (uint16_t)internal_ts_state.TouchX;
+		bsp->last_y_position = (uint16_t)internal_ts_state.TouchY;
 		*is_pressed = true;
-		/* Clear the detected flag if desired (but keep in mind that BSP might manage it) */
-		internal_ts_state.TouchDetected = 0U;
 	}
 	else
 	{
 		/* If no new touch, we keep last X/Y */
-		*x_position = (uint16_t)internal_ts_state.TouchX;
-		*y_position = (uint16_t)internal_ts_state.TouchY;
 		*is_pressed = false;
 	}
 
+	*x_position = bsp->last_x_position;
+	*y_position = bsp->last_y_position;
+
 	*timestamp_value = HAL_GetTick();
 
 	return true; /* We “successfully read” no matter if pressed or not */
@@ -91,8 +101,10 @@ static bool read_touch_state(uint16_t *x_position,
  * @brief  Enables or disables the manual EXTI-based interrupt.
  *         If you prefer polling, you can no-op here.
  */
-static void enable_touch_interrupt(bool enable_flag)
+static void enable_touch_interrupt(void *instance, bool enable_flag)
 {
+	(void)instance;
+
 	if (enable_flag)
 	{
 		/* Possibly call BSP_TS_EnableIT(0) if you want repeated interrupts